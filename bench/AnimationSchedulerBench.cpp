@@ -0,0 +1,223 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/AnimationScheduler.h"
+#include "../lib/UI/src/AnimationKernels.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::uint64_t kTickMicroseconds = 10000;
+constexpr std::uint64_t kDurationMicroseconds = 250000;
+constexpr int kTravel = 105;
+constexpr int kBulkControls = 500;
+
+constexpr std::uint64_t kSpringSettleMicroseconds = 300000;
+constexpr int kDashboardControls = 10000;
+
+const ui::AnimationCurve kLinear{ui::Easing::Linear, kDurationMicroseconds};
+const ui::SpringParams kSpring{ui::SpringFrequencyForSettleTime(kSpringSettleMicroseconds), 0.25f};
+
+// A scheduler on a virtual clock that only moves when the benchmark advances it, counting how
+// often the host is asked to start and stop its timer.
+struct VirtualHost
+{
+    std::uint64_t now = 0;
+    int starts = 0;
+    int stops = 0;
+    ui::AnimationScheduler scheduler{[this]() { return now; }, [this](bool ticking) { ++(ticking ? starts : stops); }};
+
+    const std::vector<ui::AnimationUpdate>& Tick(std::uint64_t interval = kTickMicroseconds)
+    {
+        now += interval;
+        return scheduler.Tick();
+    }
+};
+
+// Runs one animation to its end at the 10 ms tick. offset follows the updates.
+void RunToEnd(VirtualHost& host, int& offset)
+{
+    while (host.scheduler.IsTicking())
+    {
+        for (const ui::AnimationUpdate& update : host.Tick())
+        {
+            offset = update.current;
+        }
+    }
+}
+
+// One toggle flip per kind of animation at the 10 ms tick: the timer wakeups it costs and how
+// many of those moved nothing.
+void ReportSettleCost()
+{
+    struct Kind
+    {
+        const char* name;
+        ui::Easing easing;
+        bool spring;
+    };
+    const Kind kinds[] = {
+        {"linear", ui::Easing::Linear, false},
+        {"cubic", ui::Easing::Cubic, false},
+        {"spring easing", ui::Easing::Spring, false},
+        {"spring physics", ui::Easing::Linear, true},
+    };
+    for (const Kind& kind : kinds)
+    {
+        VirtualHost host;
+        int offset = 0;
+        if (kind.spring)
+        {
+            host.scheduler.AnimateSpring(&offset, 0, kTravel, kSpring);
+        }
+        else
+        {
+            host.scheduler.Animate(&offset, 0, kTravel, ui::AnimationCurve{kind.easing, kDurationMicroseconds});
+        }
+        RunToEnd(host, offset);
+        const ui::AnimationStats stats = host.scheduler.Stats();
+
+        std::printf("  %s flip: %llu wakeups, %llu moved nothing", kind.name, static_cast<unsigned long long>(stats.ticks),
+            static_cast<unsigned long long>(stats.idleTicks));
+        if (!kind.spring)
+        {
+            std::printf(" (%llu waiting out the duration)", static_cast<unsigned long long>(kDurationMicroseconds / kTickMicroseconds));
+        }
+        std::printf("\n");
+    }
+}
+
+// Animation state kept in each heap-allocated control and stepped one control at a time, as
+// before the scheduler kept lanes: the baseline for the dashboard benchmark.
+struct PerControlAnimation
+{
+    int knobOffset = 0;
+    int from = 0;
+    int to = 0;
+    std::uint64_t start = 0;
+    ui::AnimationCurve curve;
+};
+
+// 10k toggles animating at once, as on a large dashboard. Steps of 50 us keep every animation
+// in flight while timing; each frame is one Tick.
+void RunDashboardBenchmark()
+{
+    const ui::AnimationCurve curves[] = {kLinear, ui::AnimationCurve{ui::Easing::Cubic, kDurationMicroseconds}};
+
+    std::vector<std::unique_ptr<PerControlAnimation>> controls;
+    for (int i = 0; i < kDashboardControls; ++i)
+    {
+        controls.push_back(std::make_unique<PerControlAnimation>());
+        controls.back()->to = kTravel;
+        controls.back()->curve = curves[i % 2];
+    }
+    std::uint64_t now = 0;
+    std::vector<ui::AnimationUpdate> updates;
+    const double perControlNs = bench::MeasureNanoseconds(200, [&]() {
+        now += 50;
+        updates.clear();
+        for (const std::unique_ptr<PerControlAnimation>& control : controls)
+        {
+            const double t = static_cast<double>(now - control->start) / static_cast<double>(control->curve.durationMicroseconds);
+            const int current = control->from + static_cast<int>(std::lround((control->to - control->from) * ui::EaseProgress(control->curve.easing, t)));
+            if (current != control->knobOffset)
+            {
+                updates.push_back(ui::AnimationUpdate{control.get(), control->knobOffset, current, false});
+                control->knobOffset = current;
+            }
+        }
+        bench::Consume(updates.size());
+    });
+
+    VirtualHost host;
+    std::vector<int> offsets(kDashboardControls, 0);
+    for (std::size_t i = 0; i < offsets.size(); ++i)
+    {
+        host.scheduler.Animate(&offsets[i], 0, kTravel, curves[i % 2]);
+    }
+    long long reported = 0;
+    const double curveNs = bench::MeasureNanoseconds(200, [&]() {
+        host.now += 50;
+        reported += static_cast<long long>(host.scheduler.Tick().size());
+    });
+
+    for (int& offset : offsets)
+    {
+        host.scheduler.AnimateSpring(&offset, 0, kTravel, kSpring);
+    }
+    const double springNs = bench::MeasureNanoseconds(200, [&]() {
+        host.now += 50;
+        bench::Consume(host.scheduler.Tick().size());
+    });
+
+    const std::string count = std::to_string(kDashboardControls);
+    bench::Report(("  frame of " + count + " curves, per-control state").c_str(), perControlNs);
+    bench::Report(("  frame of " + count + " curves, lanes").c_str(), curveNs);
+    bench::Report(("  frame of " + count + " springs, lanes").c_str(), springNs);
+    std::printf("  %.1f of %d controls reported moved per 50 us frame\n", static_cast<double>(reported) / 200.0, kDashboardControls);
+
+    // The curve kernel alone over the same lanes.
+    std::vector<float> starts(kDashboardControls, 0.0f);
+    std::vector<float> durations(kDashboardControls, static_cast<float>(kDurationMicroseconds));
+    std::vector<std::int32_t> froms(kDashboardControls, 0);
+    std::vector<float> distances(kDashboardControls, static_cast<float>(kTravel));
+    std::vector<std::int32_t> positions(kDashboardControls, 0);
+    std::vector<std::int32_t> next(kDashboardControls);
+    std::vector<std::uint8_t> flags(kDashboardControls);
+    for (const ui::PixelKernel kernel : {ui::PixelKernel::Scalar, ui::PixelKernel::Sse2, ui::PixelKernel::Neon})
+    {
+        if (!ui::IsPixelKernelSupported(kernel))
+        {
+            continue;
+        }
+        float at = 0.0f;
+        const double ns = bench::MeasureNanoseconds(200, [&]() {
+            at += 50.0f;
+            ui::EvaluateCurves(kernel, ui::Easing::Cubic, at,
+                ui::CurveBatch{starts.data(), durations.data(), froms.data(), distances.data(), positions.data(), next.data(), flags.data(),
+                    flags.size()});
+            bench::Consume(flags[flags.size() / 2]);
+        });
+        bench::Report(("  cubic kernel over " + count + " lanes, " + ui::PixelKernelName(kernel)).c_str(), ns);
+    }
+}
+} // namespace
+
+// Runs a bulk "select all" through the scheduler under a virtual clock and compares its timer
+// wakeups with one timer per control, then times frames of many animating controls.
+void RunAnimationSchedulerBenchmark()
+{
+    std::printf("== shared animation scheduler ==\n");
+
+    VirtualHost host;
+    std::vector<int> offsets(kBulkControls, 0);
+    for (int& offset : offsets)
+    {
+        host.scheduler.Animate(&offset, 0, kTravel, kLinear);
+    }
+
+    long long ticks = 0;
+    long long updates = 0;
+    while (host.scheduler.IsTicking())
+    {
+        for (const ui::AnimationUpdate& update : host.Tick())
+        {
+            *static_cast<int*>(update.owner) = update.current;
+            ++updates;
+        }
+        ++ticks;
+    }
+
+    // The per-control timer took one more tick per control to notice it had arrived.
+    const long long perControlWakeups = (ticks + 1) * kBulkControls;
+    std::printf("  select all on %d toggles: %lld timer wakeups shared vs %lld with a timer per control (%lld knob moves)\n",
+        kBulkControls, ticks, perControlWakeups, updates);
+
+    ReportSettleCost();
+    RunDashboardBenchmark();
+}
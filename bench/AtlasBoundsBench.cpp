@@ -0,0 +1,60 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/Atlas.h"
+
+#include <cstddef>
+#include <cstdio>
+
+namespace
+{
+struct AtlasCase
+{
+    const char* fileName;
+    int columns;
+    int rows;
+};
+
+// Matches the grids EnsureAtlasesLoaded uses: 5x2 body styles, 3x2 switch styles.
+const AtlasCase kAtlasCases[] = {
+    {"switch-body.png", 5, 2},
+    {"Switch.png", 3, 2},
+};
+
+constexpr int kFrames = 200;
+} // namespace
+
+// Per-frame cost of finding a tile's crop rectangle: rescanning alpha vs. table lookup.
+void RunAtlasBoundsBenchmark()
+{
+    std::printf("== visible bounds, mean cost per tile draw ==\n");
+
+    for (const AtlasCase& atlasCase : kAtlasCases)
+    {
+        const fixtures::RgbaImage image = fixtures::LoadAssetImage(atlasCase.fileName);
+        const std::vector<ui::TileRect> tiles = ui::BuildTileGrid(image.width, image.height, atlasCase.columns, atlasCase.rows);
+        const std::vector<ui::TileRect> table = ui::ComputeVisibleBoundsTable(image.pixels.data(), image.width, tiles);
+
+        const double scanNs = bench::MeasureNanoseconds(kFrames, [&]() {
+            long long area = 0;
+            for (const ui::TileRect& tile : tiles)
+            {
+                const ui::TileRect crop = ui::ComputeVisibleBounds(image.pixels.data(), image.width, tile);
+                area += crop.width * crop.height;
+            }
+            bench::Consume(area);
+        });
+
+        const double lookupNs = bench::MeasureNanoseconds(kFrames * 1000, [&]() {
+            long long area = 0;
+            for (std::size_t i = 0; i < tiles.size(); ++i)
+            {
+                area += table[i].width * table[i].height;
+            }
+            bench::Consume(area);
+        });
+
+        std::printf("%s (%zu tiles)\n", atlasCase.fileName, tiles.size());
+        bench::Report("  rescan alpha every frame", scanNs / tiles.size());
+        bench::Report("  precomputed table lookup", lookupNs / tiles.size());
+    }
+}
@@ -0,0 +1,41 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/AtlasPacker.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 10;
+} // namespace
+
+// Compares PNG decoding with mapping a baked .tglatlas (both with a warm file cache).
+void RunAtlasFileBenchmark()
+{
+    std::printf("== atlas load: PNG decode vs. mapped .tglatlas ==\n");
+
+    const fixtures::DecodedAtlas reference = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const ui::PackedAtlas packed = ui::PackVisibleTiles(reference.pixels.data(), reference.width, reference.visibleBounds);
+    const std::vector<unsigned char> bytes = ui::SerializeAtlasFile(reference.width, reference.height, 5, 2, reference.tiles,
+        reference.visibleBounds, packed.width, packed.height, packed.packedBounds, packed.pixels.data());
+    const std::string bakedPath = fixtures::TempFilePath("switch-body.tglatlas");
+    ui::WriteAtlasFile(bakedPath, bytes);
+
+    const double pngNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        const fixtures::DecodedAtlas atlas = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+        bench::Consume(atlas.pixels[atlas.pixels.size() / 2]);
+    });
+
+    const double mappedNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        const ui::MappedFile file(bakedPath);
+        const ui::AtlasFileView view = ui::ParseAtlasFile(file.data(), file.size());
+        bench::Consume(view.pixels[static_cast<std::size_t>(view.width) * view.height * 2]);
+    });
+
+    bench::Report("  stbi_load + premultiply + bounds scan", pngNs);
+    bench::Report("  map + validate .tglatlas (checksum pass)", mappedNs);
+    std::remove(bakedPath.c_str());
+}
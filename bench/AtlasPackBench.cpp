@@ -0,0 +1,38 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/AtlasPacker.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 20;
+} // namespace
+
+// Repacks both atlases to their visible tile parts and reports the resident bytes saved.
+void RunAtlasPackBenchmark()
+{
+    std::printf("== tight atlas repacking (skyline) ==\n");
+
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const fixtures::DecodedAtlas atlas = fixtures::DecodeAtlas(layout);
+        ui::PackedAtlas packed;
+        const double ns = bench::MeasureNanoseconds(kIterations, [&]() {
+            packed = ui::PackVisibleTiles(atlas.pixels.data(), atlas.width, atlas.visibleBounds);
+        });
+
+        std::size_t visibleBytes = 0;
+        for (const ui::TileRect& bounds : atlas.visibleBounds)
+        {
+            visibleBytes += static_cast<std::size_t>(bounds.width) * bounds.height * 4;
+        }
+        std::printf("  %s: %dx%d grid (%zu bytes) -> %dx%d packed (%zu bytes, %.0f%% of it visible pixels)\n",
+            layout.name, atlas.width, atlas.height, atlas.pixels.size(), packed.width, packed.height, packed.pixels.size(),
+            100.0 * static_cast<double>(visibleBytes) / static_cast<double>(packed.pixels.size()));
+        bench::Report(("  " + std::string(layout.name) + ": pack visible tiles").c_str(), ns);
+    }
+}
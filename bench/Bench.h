@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../tests/Fixtures.h"
+
+// Minimal timing harness shared by the UIToggle benchmarks.
+namespace bench
+{
+// Mean wall time of one call to fn, in nanoseconds, over the given number of iterations.
+template <typename Fn>
+double MeasureNanoseconds(int iterations, Fn&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        fn();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+void Report(const char* name, double nanoseconds);
+
+// Reports a timing together with the rate it implies for the given number of pixels.
+void ReportThroughput(const char* name, double nanoseconds, std::size_t pixels);
+
+// Keeps benchmark results observable so the optimizer cannot drop the measured work.
+void Consume(long long value);
+} // namespace bench
+
+void RunAtlasBoundsBenchmark();
+void RunPixelKernelsBenchmark();
+void RunCompositorBenchmark();
+void RunAtlasFileBenchmark();
+void RunAtlasPackBenchmark();
+void RunDirectDecodeBenchmark();
+void RunEmbeddedAtlasBenchmark();
+void RunHeadlessRenderBenchmark();
+void RunDirtyRectBenchmark();
+void RunFrameCacheBenchmark();
+void RunTileCacheBenchmark();
+void RunMipChainBenchmark();
+void RunRleTileBenchmark();
+void RunAnimationSchedulerBenchmark();
+void RunParallelDecodeBenchmark();
+void RunStartupLatencyBenchmark();
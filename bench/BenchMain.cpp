@@ -0,0 +1,67 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+volatile long long g_sink = 0;
+} // namespace
+
+namespace bench
+{
+void Report(const char* name, double nanoseconds)
+{
+    std::printf("%-48s %12.1f ns\n", name, nanoseconds);
+}
+
+void ReportThroughput(const char* name, double nanoseconds, std::size_t pixels)
+{
+    const double megapixelsPerSecond = static_cast<double>(pixels) * 1000.0 / nanoseconds;
+    std::printf("%-48s %12.1f ns %10.1f Mpx/s\n", name, nanoseconds, megapixelsPerSecond);
+}
+
+void Consume(long long value)
+{
+    g_sink = g_sink + value;
+}
+} // namespace bench
+
+// Usage: UIToggleBench [asset-directory]
+int main(int argc, char** argv)
+{
+    if (argc > 1)
+    {
+        fixtures::SetAssetDirectory(argv[1]);
+    }
+
+    try
+    {
+        RunAtlasBoundsBenchmark();
+        RunPixelKernelsBenchmark();
+        RunCompositorBenchmark();
+        RunAtlasFileBenchmark();
+        RunAtlasPackBenchmark();
+        RunDirectDecodeBenchmark();
+        RunEmbeddedAtlasBenchmark();
+        RunHeadlessRenderBenchmark();
+        RunDirtyRectBenchmark();
+        RunFrameCacheBenchmark();
+        RunTileCacheBenchmark();
+        RunMipChainBenchmark();
+        RunRleTileBenchmark();
+        RunAnimationSchedulerBenchmark();
+        RunParallelDecodeBenchmark();
+        RunStartupLatencyBenchmark();
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "benchmark failed: %s\n", error.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/Compositor.h"
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+const ui::PixelKernel kKernels[] = {ui::PixelKernel::Scalar, ui::PixelKernel::Sse2, ui::PixelKernel::Avx2, ui::PixelKernel::Neon};
+
+constexpr int kIterations = 200;
+
+// The two SrcOver layers of a golden frame, blended over frame through one kernel. The tiles
+// are resampled once up front (fixtures::ScaleSceneTiles) so that timed composites measure
+// blending alone; MipChainBench.cpp times the resampling.
+void CompositeScene(ui::PixelKernel kernel, const fixtures::SceneTiles& tiles, const ui::SurfaceView& frame, const ui::TileRect& clip)
+{
+    const ui::TileRect bodySource{0, 0, tiles.bodyRect.width, tiles.bodyRect.height};
+    const ui::ImageView bodyImage{tiles.body.data(), bodySource.width, bodySource.height, bodySource.width * 4};
+    ui::CompositeSrcOver(kernel, frame, tiles.bodyRect, bodyImage, bodySource, clip);
+
+    const ui::TileRect knobSource{0, 0, tiles.knobRect.width, tiles.knobRect.height};
+    const ui::ImageView knobImage{tiles.knob.data(), knobSource.width, knobSource.height, knobSource.width * 4};
+    ui::CompositeSrcOver(kernel, frame, tiles.knobRect, knobImage, knobSource, clip);
+}
+
+// Pixels both layers of a scene blend.
+std::size_t LayerPixels(const fixtures::SceneTiles& tiles)
+{
+    return static_cast<std::size_t>(tiles.bodyRect.width) * tiles.bodyRect.height +
+        static_cast<std::size_t>(tiles.knobRect.width) * tiles.knobRect.height;
+}
+
+// Times the two SrcOver layers of scene over a frame filled once outside the loop. Blending
+// the same layers again costs the same: the kernels branch on source alpha only.
+double MeasureSceneComposite(ui::PixelKernel kernel, const fixtures::GoldenScene& scene, const fixtures::SceneTiles& tiles, int iterations)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(scene.width) * scene.height * 4);
+    const ui::SurfaceView frame{pixels.data(), scene.width, scene.height, scene.width * 4};
+    const ui::TileRect bounds{0, 0, scene.width, scene.height};
+    ui::FillSurface(frame, bounds, fixtures::kGoldenBackground);
+    return bench::MeasureNanoseconds(iterations, [&]() {
+        CompositeScene(kernel, tiles, frame, bounds);
+        bench::Consume(pixels[0]);
+    });
+}
+} // namespace
+
+// Measures compositing throughput per kernel on the golden frames.
+void RunCompositorBenchmark()
+{
+    std::printf("== software compositor, premultiplied SrcOver (active: %s) ==\n", ui::PixelKernelName(ui::ActivePixelKernel()));
+
+    const fixtures::DecodedAtlas body = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const fixtures::DecodedAtlas knob = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+    const fixtures::GoldenScene& native = fixtures::GoldenScenes()[1];
+    const fixtures::GoldenScene& upscaled = fixtures::GoldenScenes()[2];
+    const fixtures::SceneTiles nativeTiles = fixtures::ScaleSceneTiles(native, body, knob);
+    const fixtures::SceneTiles upscaledTiles = fixtures::ScaleSceneTiles(upscaled, body, knob);
+    const std::size_t nativePixels = LayerPixels(nativeTiles);
+    const std::size_t upscaledPixels = LayerPixels(upscaledTiles);
+
+    for (ui::PixelKernel kernel : kKernels)
+    {
+        if (!ui::IsPixelKernelSupported(kernel))
+        {
+            continue;
+        }
+
+        const double nativeNs = MeasureSceneComposite(kernel, native, nativeTiles, kIterations);
+        const double upscaledNs = MeasureSceneComposite(kernel, upscaled, upscaledTiles, kIterations / 4);
+
+        const std::string name = ui::PixelKernelName(kernel);
+        bench::ReportThroughput(("  " + name + ": toggle frame 1:1 (2 layers)").c_str(), nativeNs, nativePixels);
+        bench::ReportThroughput(("  " + name + ": toggle frame 2x (2 layers)").c_str(), upscaledNs, upscaledPixels);
+    }
+}
@@ -0,0 +1,58 @@
+#include "Bench.h"
+
+#include "../lib/UI/include/stb_image.h"
+#include "../lib/UI/src/ImageDecode.h"
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 10;
+} // namespace
+
+// Compares the previous PNG path (stbi_load into a heap buffer, then convert into the
+// surface) with decoding straight into the surface and converting in place.
+void RunDirectDecodeBenchmark()
+{
+    std::printf("== PNG decode: heap buffer + convert vs. decode into surface ==\n");
+
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const std::string path = fixtures::AssetDirectory() + "/" + layout.name + ".png";
+
+        int width = 0;
+        int height = 0;
+        ui::ReadImageSize(path.c_str(), width, height);
+        const std::size_t imageBytes = static_cast<std::size_t>(width) * height * 4;
+        std::vector<unsigned char> copiedSurface(imageBytes);
+        std::vector<unsigned char> directSurface(imageBytes);
+
+        const double copiedNs = bench::MeasureNanoseconds(kIterations, [&]() {
+            int decodedWidth = 0;
+            int decodedHeight = 0;
+            int channels = 0;
+            unsigned char* rgba = stbi_load(path.c_str(), &decodedWidth, &decodedHeight, &channels, 4);
+            if (rgba == nullptr)
+            {
+                throw std::runtime_error("Failed to load " + path);
+            }
+            ui::PremultiplyRgbaToBgraRows(rgba, copiedSurface.data(), width, height);
+            stbi_image_free(rgba);
+        });
+
+        const double directNs = bench::MeasureNanoseconds(kIterations, [&]() {
+            ui::DecodeRgbaInto(path.c_str(), directSurface.data(), width, height);
+            ui::PremultiplyRgbaToBgraRows(directSurface.data(), directSurface.data(), width, height);
+        });
+
+        std::printf("  %s (%dx%d): image-sized buffers at peak 2 -> 1 (%zu KiB each)\n",
+            layout.name, width, height, imageBytes / 1024);
+        bench::ReportThroughput("    stbi_load + convert into surface", copiedNs, imageBytes / 4);
+        bench::ReportThroughput("    decode into surface + in-place convert", directNs, imageBytes / 4);
+    }
+}
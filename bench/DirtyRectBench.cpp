@@ -0,0 +1,88 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/ToggleRenderer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr int kStepPixels = 4; // kAnimationStepPixels in Toggle.cpp
+constexpr int kIterations = 20;
+
+struct SweepResult
+{
+    int frames = 0;
+    long long pixelsTouched = 0;
+};
+
+// Animates the knob off -> on -> off one step per frame, the way ToggleControl::AnimateStep
+// does, recomposing either the whole frame or only the knob sweep into a persistent buffer.
+SweepResult Sweep(const ui::ToggleAtlases* atlases, const fixtures::GoldenScene& scene, std::vector<unsigned char>& frame, bool damageOnly)
+{
+    const ui::SurfaceView target{frame.data(), scene.width, scene.height, scene.width * 4};
+    const ui::TileRect bounds{0, 0, scene.width, scene.height};
+    const int travel = ui::KnobTravel(atlases);
+
+    ui::ToggleAppearance appearance;
+    appearance.bodyStyle = scene.bodyStyle;
+    appearance.switchStyle = scene.switchStyle;
+    ui::RenderToggle(target, bounds, fixtures::kGoldenBackground, atlases, appearance);
+
+    SweepResult result;
+    for (int leg = 0; leg < 2; ++leg)
+    {
+        const int targetOffset = leg == 0 ? travel : 0;
+        while (appearance.knobOffset != targetOffset)
+        {
+            const int previous = appearance.knobOffset;
+            appearance.knobOffset = previous < targetOffset ? std::min(previous + kStepPixels, targetOffset)
+                                                            : std::max(previous - kStepPixels, targetOffset);
+
+            const ui::TileRect clip = damageOnly
+                ? ui::UnionRects(ui::KnobRect(atlases, scene.switchStyle, scene.width, scene.height, previous),
+                      ui::KnobRect(atlases, scene.switchStyle, scene.width, scene.height, appearance.knobOffset))
+                : bounds;
+            ui::RenderToggle(target, clip, fixtures::kGoldenBackground, atlases, appearance);
+            ++result.frames;
+            result.pixelsTouched += static_cast<long long>(clip.width) * clip.height;
+        }
+    }
+    return result;
+}
+} // namespace
+
+// Reports the pixels full-frame and knob-sweep repaints touch per frame during an animation
+// and times both.
+void RunDirtyRectBenchmark()
+{
+    std::printf("== dirty-rect knob animation ==\n");
+
+    const std::unique_ptr<ui::ToggleAtlases> atlases = ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    std::vector<unsigned char> frame(static_cast<std::size_t>(scene.width) * scene.height * 4);
+    const SweepResult full = Sweep(atlases.get(), scene, frame, false);
+    const SweepResult damage = Sweep(atlases.get(), scene, frame, true);
+
+    const long long clientPixels = static_cast<long long>(scene.width) * scene.height;
+    std::printf("  %d frames per off-on-off sweep at %dx%d, %d px per step\n", damage.frames, scene.width, scene.height, kStepPixels);
+    std::printf("  full frame: %lld px/frame; knob sweep: %lld px/frame (%.1f%% of the client area)\n",
+        full.pixelsTouched / full.frames,
+        damage.pixelsTouched / damage.frames,
+        100.0 * static_cast<double>(damage.pixelsTouched) / (static_cast<double>(clientPixels) * damage.frames));
+
+    const double fullNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        bench::Consume(Sweep(atlases.get(), scene, frame, false).pixelsTouched);
+    });
+    const double damageNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        bench::Consume(Sweep(atlases.get(), scene, frame, true).pixelsTouched);
+    });
+    bench::Report("  sweep, full-frame repaints", fullNs);
+    bench::Report("  sweep, knob-sweep repaints", damageNs);
+}
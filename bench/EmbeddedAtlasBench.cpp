@@ -0,0 +1,29 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/EmbeddedAtlases.h"
+
+#include <cstdio>
+#include <string>
+
+// Times the in-memory load path the DLL uses for the atlases compiled in by
+// UI_TOGGLE_EMBED_ASSETS.
+void RunEmbeddedAtlasBenchmark()
+{
+    std::printf("== embedded atlases ==\n");
+
+#if defined(UI_TOGGLE_EMBEDDED_ATLASES)
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const double ns = bench::MeasureNanoseconds(20, [&]() {
+            const ui::ImageAtlas atlas = ui::LoadEmbeddedAtlas(layout);
+            bench::Consume(atlas.pixels[static_cast<std::size_t>(atlas.width) * atlas.height * 2]);
+        });
+
+        const std::string label = std::string("  ") + layout.name + ": validate, pixels read in place until compressed";
+        bench::Report(label.c_str(), ns);
+    }
+#else
+    std::printf("  skipped (configure with -DUI_TOGGLE_EMBED_ASSETS=ON)\n");
+#endif
+}
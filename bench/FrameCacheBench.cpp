@@ -0,0 +1,53 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/FrameCache.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 200;
+
+ui::ToggleAppearance AppearanceFor(const fixtures::GoldenScene& scene)
+{
+    ui::ToggleAppearance appearance;
+    appearance.bodyStyle = scene.bodyStyle;
+    appearance.switchStyle = scene.switchStyle;
+    appearance.knobOffset = scene.knobOffset;
+    return appearance;
+}
+} // namespace
+
+// Compares composing a frame with copying it out of the cache.
+void RunFrameCacheBenchmark()
+{
+    std::printf("== composed frame cache ==\n");
+
+    const std::unique_ptr<ui::ToggleAtlases> atlases = ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+
+    ui::FrameCache cache(ui::kDefaultFrameCacheBudget);
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    const std::size_t frameBytes = static_cast<std::size_t>(scene.width) * scene.height * 4;
+    const ui::ToggleAppearance appearance = AppearanceFor(scene);
+    std::vector<unsigned char> pixels(frameBytes);
+    const ui::SurfaceView target{pixels.data(), scene.width, scene.height, scene.width * 4};
+    const ui::TileRect bounds{0, 0, scene.width, scene.height};
+    const double composeNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::RenderToggle(target, bounds, fixtures::kGoldenBackground, atlases.get(), appearance);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    ui::GetComposedFrame(cache, *atlases, appearance, fixtures::kGoldenBackground, scene.width, scene.height);
+    const double copyNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        const auto frame = ui::GetComposedFrame(cache, *atlases, appearance, fixtures::kGoldenBackground, scene.width, scene.height);
+        ui::CopyFrame(target, *frame, bounds);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    const std::size_t pixelCount = static_cast<std::size_t>(scene.width) * scene.height;
+    bench::ReportThroughput("  315x125 frame composed", composeNs, pixelCount);
+    bench::ReportThroughput("  315x125 frame copied from the cache", copyNs, pixelCount);
+}
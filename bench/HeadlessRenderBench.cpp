@@ -0,0 +1,30 @@
+#include "Bench.h"
+
+#include "../lib/UI/include/ToggleRender.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 200;
+} // namespace
+
+// Measures whole-frame renders through the headless C API.
+void RunHeadlessRenderBenchmark()
+{
+    std::printf("== headless rendering (UIToggle_RenderToBuffer) ==\n");
+
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    std::vector<unsigned char> frame(static_cast<std::size_t>(scene.width) * scene.height * 4);
+    UIToggleRenderParams onParams{};
+    onParams.body_style = scene.bodyStyle;
+    onParams.switch_style = scene.switchStyle;
+    onParams.knob_offset = scene.knobOffset;
+    onParams.background = fixtures::kGoldenBackground;
+    const double ns = bench::MeasureNanoseconds(kIterations, [&]() {
+        UIToggle_RenderToBuffer(&onParams, frame.data(), scene.width, scene.height, scene.width * 4);
+        bench::Consume(frame[frame.size() / 2]);
+    });
+    bench::ReportThroughput("  315x125 frame through the C API", ns, static_cast<std::size_t>(scene.width) * scene.height);
+}
@@ -0,0 +1,82 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/Resample.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 20;
+
+struct TargetSize
+{
+    const char* name;
+    int width;
+    int height;
+};
+
+const TargetSize kTargets[] = {
+    {"150x60", 150, 60},
+    {"120x50", 120, 50},
+    {"60x24", 60, 24},
+};
+} // namespace
+
+// Scales the body tile to control sizes below the authored one, straight from the atlas and
+// from the closest mip level, and reports the source bytes each reads. Then times resampling
+// the layers of the golden toggle frames that CompositorBench.cpp blends.
+void RunMipChainBenchmark()
+{
+    std::printf("== mip chains for downscaled tiles ==\n");
+
+    const fixtures::DecodedAtlas body = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const ui::ImageView source{body.pixels.data(), body.width, body.height, body.width * 4};
+    const ui::TileRect bounds = body.visibleBounds[0];
+
+    std::vector<ui::MipLevel> chain;
+    const double buildNs = bench::MeasureNanoseconds(kIterations, [&]() { chain = ui::BuildMipChain(source, bounds); });
+    std::printf("  %dx%d tile, %zu levels down to %dx%d\n", bounds.width, bounds.height, chain.size(), chain.back().width, chain.back().height);
+    bench::Report("  build chain for one tile", buildNs);
+
+    for (const TargetSize& size : kTargets)
+    {
+        const ui::MipLevel* level = ui::SelectMipLevel(chain, size.width, size.height);
+
+        std::vector<unsigned char> pixels(static_cast<std::size_t>(size.width) * size.height * 4);
+        const ui::SurfaceView target{pixels.data(), size.width, size.height, size.width * 4};
+        const ui::ImageView levelView{level->pixels.data(), level->width, level->height, level->width * 4};
+        const double baseNs = bench::MeasureNanoseconds(kIterations, [&]() {
+            ui::ResampleImage(source, bounds, target);
+            bench::Consume(pixels[0]);
+        });
+        const double mipNs = bench::MeasureNanoseconds(kIterations, [&]() {
+            ui::ResampleImage(levelView, ui::TileRect{0, 0, level->width, level->height}, target);
+            bench::Consume(pixels[0]);
+        });
+
+        const std::size_t baseBytes = static_cast<std::size_t>(bounds.width) * bounds.height * 4;
+        const std::size_t mipBytes = level->pixels.size();
+        std::printf("  %s: reads %zu bytes from %dx%d instead of %zu (%.1fx less)\n",
+            size.name, mipBytes, level->width, level->height, baseBytes, static_cast<double>(baseBytes) / mipBytes);
+        bench::Report(("  " + std::string(size.name) + ", from the atlas").c_str(), baseNs);
+        bench::Report(("  " + std::string(size.name) + ", from the mip level").c_str(), mipNs);
+    }
+
+    // What a tile-cache miss costs per golden toggle frame: both layers chained and resampled.
+    // CompositorBench.cpp times the blending of the same layers.
+    const fixtures::DecodedAtlas knob = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+    for (const fixtures::GoldenScene* scene : {&fixtures::GoldenScenes()[1], &fixtures::GoldenScenes()[2]})
+    {
+        fixtures::SceneTiles tiles;
+        const double scaleNs = bench::MeasureNanoseconds(kIterations, [&]() {
+            tiles = fixtures::ScaleSceneTiles(*scene, body, knob);
+            bench::Consume(tiles.body[0] + tiles.knob[0]);
+        });
+        const std::size_t pixels = static_cast<std::size_t>(tiles.bodyRect.width) * tiles.bodyRect.height +
+            static_cast<std::size_t>(tiles.knobRect.width) * tiles.knobRect.height;
+        const std::string name = "  " + std::to_string(scene->width) + "x" + std::to_string(scene->height) + " toggle tiles resampled (2 layers)";
+        bench::ReportThroughput(name.c_str(), scaleNs, pixels);
+    }
+}
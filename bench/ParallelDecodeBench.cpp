@@ -0,0 +1,65 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/Parallel.h"
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+const ui::AtlasLayout kLayouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+constexpr std::size_t kLayoutCount = sizeof(kLayouts) / sizeof(kLayouts[0]);
+
+constexpr int kIterations = 5;
+
+// Large enough that PremultiplyRgbaToBgraRows splits it into one band per core.
+constexpr int kBandImageWidth = 2048;
+constexpr int kBandImageHeight = 1024;
+} // namespace
+
+// Cold decode of every atlas, one after another versus fanned out with ParallelFor, plus
+// the banded conversion against a single pass.
+void RunParallelDecodeBenchmark()
+{
+    std::printf("== parallel decode, %u hardware threads ==\n", ui::ParallelismDegree());
+
+    fixtures::DecodedAtlas serial[kLayoutCount];
+    fixtures::DecodedAtlas parallel[kLayoutCount];
+
+    double slowestSingleNs = 0.0;
+    for (std::size_t i = 0; i < kLayoutCount; ++i)
+    {
+        slowestSingleNs = std::max(slowestSingleNs, bench::MeasureNanoseconds(kIterations, [&]() {
+            serial[i] = fixtures::DecodeAtlas(kLayouts[i]);
+        }));
+    }
+    bench::Report("  slowest single atlas decode", slowestSingleNs);
+
+    bench::Report("  all atlases, serial", bench::MeasureNanoseconds(kIterations, [&]() {
+        for (std::size_t i = 0; i < kLayoutCount; ++i)
+        {
+            serial[i] = fixtures::DecodeAtlas(kLayouts[i]);
+        }
+    }));
+    bench::Report("  all atlases, ParallelFor", bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::ParallelFor(kLayoutCount, [&](std::size_t i) { parallel[i] = fixtures::DecodeAtlas(kLayouts[i]); });
+    }));
+
+    const std::size_t pixelCount = static_cast<std::size_t>(kBandImageWidth) * kBandImageHeight;
+    std::vector<unsigned char> source(pixelCount * 4);
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<unsigned char>(i * 31 + (i >> 9));
+    }
+    std::vector<unsigned char> singlePass(source.size());
+    std::vector<unsigned char> banded(source.size());
+
+    bench::ReportThroughput("  premultiply, single pass", bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::PremultiplyRgbaToBgra(source.data(), singlePass.data(), pixelCount);
+    }), pixelCount);
+    bench::ReportThroughput("  premultiply, row bands", bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::PremultiplyRgbaToBgraRows(source.data(), banded.data(), kBandImageWidth, kBandImageHeight);
+    }), pixelCount);
+}
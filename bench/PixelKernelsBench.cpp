@@ -0,0 +1,62 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+const ui::PixelKernel kKernels[] = {ui::PixelKernel::Scalar, ui::PixelKernel::Sse2, ui::PixelKernel::Avx2, ui::PixelKernel::Neon};
+
+constexpr int kIterations = 20;
+
+// The per-pixel float loop LoadAtlas used before the fused kernel (RGBA order, truncating).
+void LegacyPremultiply(unsigned char* pixels, std::size_t pixelCount)
+{
+    for (std::size_t i = 0; i < pixelCount; ++i)
+    {
+        unsigned char* pixel = &pixels[i * 4];
+        const float alpha = static_cast<float>(pixel[3]) / 255.0f;
+        pixel[0] = static_cast<unsigned char>(pixel[0] * alpha);
+        pixel[1] = static_cast<unsigned char>(pixel[1] * alpha);
+        pixel[2] = static_cast<unsigned char>(pixel[2] * alpha);
+    }
+}
+} // namespace
+
+// Measures each supported premultiply kernel on the body atlas; tests/PixelKernelsTest.cpp
+// checks them against the scalar reference.
+void RunPixelKernelsBenchmark()
+{
+    std::printf("== premultiply + swizzle, switch-body.png (active: %s) ==\n", ui::PixelKernelName(ui::ActivePixelKernel()));
+
+    const fixtures::RgbaImage image = fixtures::LoadAssetImage("switch-body.png");
+    const std::size_t pixelCount = image.pixels.size() / 4;
+    std::vector<unsigned char> output(image.pixels.size());
+
+    std::vector<unsigned char> legacy = image.pixels;
+    const double legacyNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        std::memcpy(legacy.data(), image.pixels.data(), image.pixels.size());
+        LegacyPremultiply(legacy.data(), pixelCount);
+        bench::Consume(legacy[pixelCount * 2]);
+    });
+    bench::ReportThroughput("  legacy float loop (copy + premultiply)", legacyNs, pixelCount);
+
+    for (ui::PixelKernel kernel : kKernels)
+    {
+        if (!ui::IsPixelKernelSupported(kernel))
+        {
+            continue;
+        }
+
+        const double ns = bench::MeasureNanoseconds(kIterations, [&]() {
+            ui::PremultiplyRgbaToBgra(kernel, image.pixels.data(), output.data(), pixelCount);
+            bench::Consume(output[pixelCount * 2]);
+        });
+
+        const std::string label = std::string("  ") + ui::PixelKernelName(kernel);
+        bench::ReportThroughput(label.c_str(), ns, pixelCount);
+    }
+}
@@ -0,0 +1,126 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/AtlasPacker.h"
+#include "../lib/UI/src/Resample.h"
+#include "../lib/UI/src/RleTile.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 200;
+
+struct AtlasCase
+{
+    ui::AtlasLayout layout;
+    int sampleTile; // timed on its own and at the default control size
+};
+
+const AtlasCase kCases[] = {
+    {ui::kBodyAtlasLayout, 0},
+    {ui::kSwitchAtlasLayout, 2},
+};
+
+std::vector<unsigned char> Backdrop(int width, int height)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        pixels[i] = static_cast<unsigned char>(i * 5);
+        pixels[i + 1] = static_cast<unsigned char>(i * 11);
+        pixels[i + 2] = static_cast<unsigned char>(i * 3);
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+void ReportBlit(const char* name, const ui::ImageView& image, const ui::TileRect& rect, const ui::RleTile& tile)
+{
+    std::vector<unsigned char> pixels = Backdrop(rect.width, rect.height);
+    const ui::SurfaceView target{pixels.data(), rect.width, rect.height, rect.width * 4};
+    const ui::TileRect bounds{0, 0, rect.width, rect.height};
+    const double rawNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::CompositeSrcOver(target, bounds, image, rect);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    const double rleNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::CompositeSrcOverRle(target, bounds, tile, bounds);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    const std::size_t pixelCount = static_cast<std::size_t>(rect.width) * rect.height;
+    bench::ReportThroughput((std::string("  ") + name + ", raw").c_str(), rawNs, pixelCount);
+    bench::ReportThroughput((std::string("  ") + name + ", compressed").c_str(), rleNs, pixelCount);
+}
+} // namespace
+
+// Compresses the visible tile parts of both atlases and reports the resident bytes and blit
+// rates of the two forms.
+void RunRleTileBenchmark()
+{
+    std::printf("== run-length compressed tiles ==\n");
+
+    for (const AtlasCase& atlasCase : kCases)
+    {
+        const ui::AtlasLayout& layout = atlasCase.layout;
+        const fixtures::DecodedAtlas atlas = fixtures::DecodeAtlas(layout);
+        const ui::PackedAtlas packed = ui::PackVisibleTiles(atlas.pixels.data(), atlas.width, atlas.visibleBounds);
+        const ui::ImageView source{packed.pixels.data(), packed.width, packed.height, packed.width * 4};
+
+        std::vector<ui::RleTile> tiles;
+        const double ns = bench::MeasureNanoseconds(kIterations / 10, [&]() {
+            tiles.clear();
+            for (const ui::TileRect& bounds : packed.packedBounds)
+            {
+                tiles.push_back(ui::CompressTile(source, bounds));
+            }
+        });
+
+        std::size_t compressedBytes = 0;
+        for (const ui::RleTile& tile : tiles)
+        {
+            compressedBytes += tile.ByteSize();
+        }
+        std::printf("  %s: %zu bytes as a grid, %zu packed, %zu compressed (%.2fx smaller than packed)\n", layout.name,
+            atlas.pixels.size(), packed.pixels.size(), compressedBytes, static_cast<double>(packed.pixels.size()) / compressedBytes);
+        bench::Report(("  " + std::string(layout.name) + ": compress every tile").c_str(), ns);
+
+        const std::size_t sample = static_cast<std::size_t>(atlasCase.sampleTile);
+        const ui::TileRect& first = packed.packedBounds[sample];
+        ReportBlit((std::string(layout.name) + " tile").c_str(), source, first, tiles[sample]);
+
+        // The default control size, as the tile cache holds it.
+        std::vector<unsigned char> scaled(static_cast<std::size_t>(315) * 125 * 4);
+        ui::ResampleImage(source, first, ui::SurfaceView{scaled.data(), 315, 125, 315 * 4});
+        const ui::ImageView scaledView{scaled.data(), 315, 125, 315 * 4};
+        const ui::TileRect scaledRect{0, 0, 315, 125};
+        const ui::RleTile scaledTile = ui::CompressTile(scaledView, scaledRect);
+        ReportBlit((std::string(layout.name) + " at 315x125").c_str(), scaledView, scaledRect, scaledTile);
+    }
+
+    // What a loaded toggle keeps resident: the compressed tiles and their mip chains.
+    const std::unique_ptr<ui::ToggleAtlases> atlases = ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+    std::size_t residentBytes = 0;
+    std::size_t mipBytes = 0;
+    for (const ui::ImageAtlas* atlas : {&atlases->body, &atlases->knob})
+    {
+        for (const ui::RleTile& tile : atlas->compressed)
+        {
+            residentBytes += tile.ByteSize();
+        }
+        for (const std::vector<ui::MipLevel>& chain : atlas->mips)
+        {
+            for (const ui::MipLevel& level : chain)
+            {
+                mipBytes += level.pixels.size();
+            }
+        }
+    }
+    std::printf("  loaded toggle: %zu bytes of compressed tiles + %zu bytes of mip levels\n", residentBytes, mipBytes);
+}
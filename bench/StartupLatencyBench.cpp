@@ -0,0 +1,99 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/LoadCoordinator.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct AtlasSet
+{
+    fixtures::DecodedAtlas body;
+    fixtures::DecodedAtlas knob;
+};
+
+// Mirrors the DLL: the thread that claims the coordinator decodes both atlases.
+struct AtlasState
+{
+    ui::LoadCoordinator<AtlasSet> load;
+
+    void Decode()
+    {
+        std::unique_ptr<AtlasSet> atlases(new AtlasSet());
+        atlases->body = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+        atlases->knob = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+        load.Finish(std::move(atlases));
+    }
+};
+
+double MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Stands in for the host creating its windows between startup and the first WM_PAINT.
+void HostSetup(int milliseconds)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+
+void RunCase(int hostSetupMs)
+{
+    // Synchronous: the first control's paint decodes on the UI thread.
+    double syncFirstPaintMs = 0.0;
+    {
+        AtlasState state;
+        const Clock::time_point start = Clock::now();
+        HostSetup(hostSetupMs);
+        if (state.load.TryBegin())
+        {
+            state.Decode();
+        }
+        bench::Consume(state.load.Get()->body.pixels[0]);
+        syncFirstPaintMs = MillisecondsSince(start);
+    }
+
+    // Asynchronous: preload at startup, paint a placeholder if the atlases are not ready yet.
+    double asyncFirstPaintMs = 0.0;
+    double asyncFullPaintMs = 0.0;
+    bool firstPaintWasPlaceholder = false;
+    {
+        AtlasState state;
+        const Clock::time_point start = Clock::now();
+        state.load.TryBegin();
+        std::thread worker([&state]() { state.Decode(); });
+
+        HostSetup(hostSetupMs);
+        firstPaintWasPlaceholder = state.load.Get() == nullptr;
+        asyncFirstPaintMs = MillisecondsSince(start);
+
+        bench::Consume(state.load.WaitWhileLoading()->body.pixels[0]);
+        asyncFullPaintMs = MillisecondsSince(start);
+        worker.join();
+    }
+
+    std::printf("  host setup %2d ms: sync first paint %7.2f ms | async first paint %7.2f ms (%s), full %7.2f ms\n",
+        hostSetupMs,
+        syncFirstPaintMs,
+        asyncFirstPaintMs,
+        firstPaintWasPlaceholder ? "placeholder" : "atlases",
+        asyncFullPaintMs);
+}
+} // namespace
+
+// Time from process start to the first toggle paint, with and without a background preload.
+void RunStartupLatencyBenchmark()
+{
+    std::printf("== startup latency, PNG atlases ==\n");
+
+    const int hostSetupMs[] = {0, 5, 20};
+    for (int setup : hostSetupMs)
+    {
+        RunCase(setup);
+    }
+}
@@ -0,0 +1,58 @@
+#include "Bench.h"
+
+#include "../lib/UI/src/Compositor.h"
+#include "../lib/UI/src/Resample.h"
+#include "../lib/UI/src/TileCache.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+constexpr int kIterations = 50;
+
+std::vector<unsigned char> Resample(const ui::ImageView& source, const ui::TileRect& sourceRect, int width, int height)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+    ui::ResampleImage(source, sourceRect, ui::SurfaceView{pixels.data(), width, height, width * 4});
+    return pixels;
+}
+} // namespace
+
+// Compares drawing a scaled tile per frame by nearest-neighbour sampling, by resampling it
+// every time, and from the cache.
+void RunTileCacheBenchmark()
+{
+    std::printf("== pre-scaled tile cache ==\n");
+
+    const fixtures::DecodedAtlas knob = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+    const ui::ImageView source{knob.pixels.data(), knob.width, knob.height, knob.width * 4};
+    const ui::TileRect sourceRect = knob.visibleBounds[2];
+    const int width = 630;
+    const int height = 250;
+    const std::size_t tileBytes = static_cast<std::size_t>(width) * height * 4;
+
+    ui::ScaledTileCache cache(tileBytes);
+    ui::GetScaledTile(cache, source, sourceRect, width, height);
+    std::vector<unsigned char> pixels(tileBytes);
+    const ui::SurfaceView target{pixels.data(), width, height, width * 4};
+    const ui::TileRect bounds{0, 0, width, height};
+    const double nearestNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::CompositeSrcOver(target, bounds, source, sourceRect);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    const double resampleNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        std::vector<unsigned char> scaled = Resample(source, sourceRect, width, height);
+        ui::CompositeSrcOver(target, bounds, ui::ImageView{scaled.data(), width, height, width * 4}, bounds);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    const double cachedNs = bench::MeasureNanoseconds(kIterations, [&]() {
+        ui::CompositeSrcOverRle(target, bounds, *ui::GetScaledTile(cache, source, sourceRect, width, height), bounds);
+        bench::Consume(pixels[pixels.size() / 2]);
+    });
+    const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+    bench::ReportThroughput("  630x250 tile, nearest-neighbour blend", nearestNs, pixelCount);
+    bench::ReportThroughput("  630x250 tile, filtered every frame", resampleNs, pixelCount);
+    bench::ReportThroughput("  630x250 tile, filtered once and cached", cachedNs, pixelCount);
+}
@@ -2,11 +2,7 @@
 
 #include <windows.h>
 
-#ifdef UI_TOGGLE_DLL_EXPORTS
-#define UI_TOGGLE_API __declspec(dllexport)
-#else
-#define UI_TOGGLE_API __declspec(dllimport)
-#endif
+#include "ToggleRender.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +16,14 @@ typedef enum UIToggleState
     UI_TOGGLE_STATE_ON = 1
 } UIToggleState;
 
+/* Curve the knob follows between states. SPRING overshoots the end and rings down onto it. */
+typedef enum UIToggleEasing
+{
+    UI_TOGGLE_EASING_LINEAR = 0,
+    UI_TOGGLE_EASING_CUBIC = 1,
+    UI_TOGGLE_EASING_SPRING = 2
+} UIToggleEasing;
+
 typedef struct UIToggleCreateParams
 {
     HWND parent;
@@ -31,7 +35,31 @@ typedef struct UIToggleCreateParams
     int radio_group;
 } UIToggleCreateParams;
 
+/* Paint instrumentation of one control. Knob animation repaints only the strip the knob
+   sweeps, so last_frame_pixels is normally well below client_pixels. A frame copied from the
+   shared frame cache recomposes nothing; on a miss only the invalid part is recomposed. */
+typedef struct UITogglePaintStats
+{
+    unsigned long long frames;         /* WM_PAINT passes that rendered */
+    unsigned long long pixels_touched; /* pixels recomposed over all those frames */
+    int last_frame_pixels;             /* pixels recomposed by the latest frame */
+    int client_pixels;                 /* client area at the latest frame: a full repaint */
+} UITogglePaintStats;
+
+/* Knob animation instrumentation, summed over every UI thread since load. A thread's shared
+   animation timer runs only while one of its knobs is moving and stops on the tick that lands
+   the last one, so an idle process adds nothing here. */
+typedef struct UIToggleAnimationStats
+{
+    unsigned long long timer_wakeups;  /* animation timer ticks */
+    unsigned long long wasted_wakeups; /* ticks that moved no knob by a whole pixel */
+    unsigned long long knob_moves;     /* knob position changes, each invalidating one strip */
+    unsigned long long settled;        /* animations that reached their target */
+    int running_timers;                /* UI threads whose animation timer is running now */
+} UIToggleAnimationStats;
+
 UI_TOGGLE_API BOOL UIToggle_RegisterClass(HINSTANCE instance);
+UI_TOGGLE_API BOOL UIToggle_PreloadAsync(void);
 UI_TOGGLE_API UIToggleHandle UIToggle_Create(const UIToggleCreateParams* params);
 UI_TOGGLE_API void UIToggle_Destroy(UIToggleHandle handle);
 
@@ -39,7 +67,20 @@ UI_TOGGLE_API BOOL UIToggle_SetChecked(UIToggleHandle handle, BOOL checked, BOOL
 UI_TOGGLE_API BOOL UIToggle_GetChecked(UIToggleHandle handle, BOOL* checked);
 UI_TOGGLE_API BOOL UIToggle_SetSwitchStyle(UIToggleHandle handle, int style_index);
 UI_TOGGLE_API BOOL UIToggle_SetBodyStyle(UIToggleHandle handle, int style_index);
+/* Sets the knob's easing and the duration of a full travel in milliseconds (0 to 10000, 0
+   jumps). Positions follow elapsed time, so a busy UI thread drops frames rather than
+   slowing the knob. Applies from the next state change; the default is linear over 250 ms. */
+UI_TOGGLE_API BOOL UIToggle_SetAnimation(UIToggleHandle handle, UIToggleEasing easing, int duration_ms);
+/* Animates the knob with a critically damped spring instead, until the next
+   UIToggle_SetAnimation. From rest it settles in about settle_ms (1 to 10000); a state change
+   mid-flight keeps the knob's velocity and turns it around. It stops, exactly on the target,
+   once within rest_pixels (> 0) of it and nearly still. */
+UI_TOGGLE_API BOOL UIToggle_SetSpringAnimation(UIToggleHandle handle, int settle_ms, float rest_pixels);
 UI_TOGGLE_API BOOL UIToggle_GetWindow(UIToggleHandle handle, HWND* out_window);
+UI_TOGGLE_API BOOL UIToggle_GetPaintStats(UIToggleHandle handle, UITogglePaintStats* stats);
+UI_TOGGLE_API BOOL UIToggle_GetAnimationStats(UIToggleAnimationStats* stats);
+UI_TOGGLE_API BOOL UIToggle_GetFrameCacheStats(UIToggleCacheStats* stats);
+UI_TOGGLE_API BOOL UIToggle_SetFrameCacheBudget(unsigned long long byte_budget);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,60 @@
+#pragma once
+
+/* Headless toggle rendering. Portable: needs no windows.h and is also provided on other
+   platforms by the UIToggleHeadless library. Toggle.h includes it. */
+
+#include <stdint.h>
+
+#ifndef UI_TOGGLE_API
+#if defined(_WIN32)
+#ifdef UI_TOGGLE_DLL_EXPORTS
+#define UI_TOGGLE_API __declspec(dllexport)
+#else
+#define UI_TOGGLE_API __declspec(dllimport)
+#endif
+#else
+#define UI_TOGGLE_API __attribute__((visibility("default")))
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct UIToggleRenderParams
+{
+    int body_style;     /* clamped to the body atlas like UIToggle_SetBodyStyle */
+    int switch_style;   /* clamped to the switch atlas like UIToggle_SetSwitchStyle */
+    int knob_offset;    /* pixels right of the off position; UIToggle_GetKnobTravel gives on,
+                           and any value is accepted (clamped to [-width, width]) */
+    uint32_t background; /* opaque color behind the tiles, 0xAARRGGBB */
+} UIToggleRenderParams;
+
+/* Counters of a cache shared by all renders in the process. */
+typedef struct UIToggleCacheStats
+{
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long bytes_used;
+    unsigned long long byte_budget;
+    int entries;
+} UIToggleCacheStats;
+
+/* Renders a toggle into caller-owned memory: width x height premultiplied BGRA pixels (the
+   GDI 32-bit DIB order), top-down, stride bytes per row (at least width * 4). The result is
+   pixel-identical to what a control of that size paints. Loads the atlases on first use
+   and blocks until they are available. Returns nonzero on success. */
+UI_TOGGLE_API int UIToggle_RenderToBuffer(const UIToggleRenderParams* params, void* pixels, int width, int height, int stride);
+
+/* Stores the knob offset of the on position in *travel. Returns nonzero on success. */
+UI_TOGGLE_API int UIToggle_GetKnobTravel(int* travel);
+
+/* Tiles are resampled once per drawn size (box filter when shrinking, bilinear when growing)
+   and kept in an LRU cache bounded by a byte budget, 4 MiB by default. Setting the budget
+   evicts at once; zero disables the cache. Both return nonzero on success. */
+UI_TOGGLE_API int UIToggle_GetTileCacheStats(UIToggleCacheStats* stats);
+UI_TOGGLE_API int UIToggle_SetTileCacheBudget(unsigned long long byte_budget);
+
+#ifdef __cplusplus
+}
+#endif
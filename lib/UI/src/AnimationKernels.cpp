@@ -0,0 +1,377 @@
+#include "AnimationKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UI_ANIMATION_KERNELS_X86 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define UI_ANIMATION_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UI_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define UI_TARGET_SSE2
+#endif
+
+namespace ui
+{
+namespace
+{
+using CurveFn = void (*)(Easing, float, const CurveBatch&);
+using SpringFn = void (*)(const SpringBatch&);
+
+// Rounds half away from zero as value + copysign(0.5, value) truncated, which the SIMD
+// kernels reproduce exactly.
+inline std::int32_t RoundHalfAway(float value)
+{
+    return static_cast<std::int32_t>(value + std::copysign(0.5f, value));
+}
+
+inline float EaseScalar(Easing easing, float t)
+{
+    switch (easing)
+    {
+        case Easing::Cubic:
+        {
+            const float u = 1.0f - t;
+            return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+        }
+        case Easing::Spring:
+            return static_cast<float>(EaseProgress(Easing::Spring, t));
+        case Easing::Linear:
+        default:
+            return t;
+    }
+}
+
+inline std::uint8_t LaneFlags(std::int32_t next, std::int32_t position, bool settled)
+{
+    return static_cast<std::uint8_t>((next != position ? kLaneMoved : 0) | (settled ? kLaneSettled : 0));
+}
+
+void CurveLaneScalar(Easing easing, float now, const CurveBatch& batch, std::size_t i)
+{
+    const float elapsed = std::max(now - batch.starts[i], 0.0f);
+    const std::int32_t target = batch.froms[i] + static_cast<std::int32_t>(batch.distances[i]);
+    bool settled = elapsed >= batch.durations[i];
+    std::int32_t next = target;
+    if (!settled)
+    {
+        // Linear and cubic never turn back, so reaching the target ends them; the spring
+        // easing must also have less than half a pixel of swing left.
+        const float t = elapsed / batch.durations[i];
+        next = batch.froms[i] + RoundHalfAway(batch.distances[i] * EaseScalar(easing, t));
+        settled = next == target && (easing != Easing::Spring || std::fabs(batch.distances[i]) * EaseRemainingSwing(easing, t) < 0.5);
+    }
+    batch.next[i] = next;
+    batch.flags[i] = LaneFlags(next, batch.positions[i], settled);
+}
+
+void EvaluateCurvesScalar(Easing easing, float now, const CurveBatch& batch)
+{
+    for (std::size_t i = 0; i < batch.count; ++i)
+    {
+        CurveLaneScalar(easing, now, batch, i);
+    }
+}
+
+// From offset x and velocity v a critically damped spring can swing at most
+// |x| + |v + w x| / (w e) from its target, so below half a pixel its rounded position stays on
+// the target for good. Compared multiplied through by w e.
+constexpr float kE = 2.71828183f;
+
+inline bool StaysOnTarget(float offset, float velocity, float omega)
+{
+    return std::fabs(offset) * omega * kE + std::fabs(velocity + omega * offset) < 0.5f * omega * kE;
+}
+
+void SpringLaneScalar(const SpringBatch& batch, std::size_t i)
+{
+    const float omega = batch.omegas[i];
+    const float b = batch.velocities[i] + omega * batch.offsets[i];
+    const float moved = batch.offsets[i] + b * batch.steps[i];
+    const float offset = moved * batch.decays[i];
+    const float velocity = (b - omega * moved) * batch.decays[i];
+    batch.offsets[i] = offset;
+    batch.velocities[i] = velocity;
+
+    const float rest = batch.restDistances[i];
+    const bool settled = (std::fabs(offset) <= rest && std::fabs(velocity) <= rest * omega) || StaysOnTarget(offset, velocity, omega);
+    const std::int32_t next = settled ? batch.targets[i] : batch.targets[i] + RoundHalfAway(offset);
+    batch.next[i] = next;
+    batch.flags[i] = LaneFlags(next, batch.positions[i], settled);
+}
+
+void StepSpringsScalar(const SpringBatch& batch)
+{
+    for (std::size_t i = 0; i < batch.count; ++i)
+    {
+        SpringLaneScalar(batch, i);
+    }
+}
+
+#if defined(UI_ANIMATION_KERNELS_X86)
+UI_TARGET_SSE2 inline __m128i RoundHalfAwaySse2(__m128 value)
+{
+    const __m128 half = _mm_or_ps(_mm_and_ps(value, _mm_set1_ps(-0.0f)), _mm_set1_ps(0.5f));
+    return _mm_cvttps_epi32(_mm_add_ps(value, half));
+}
+
+// Writes the four lanes' flags from the next positions and the settled mask.
+UI_TARGET_SSE2 inline void StoreLaneFlagsSse2(std::uint8_t* flags, __m128i next, __m128i positions, __m128 settled)
+{
+    const int same = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(next, positions)));
+    const int done = _mm_movemask_ps(settled);
+    for (int k = 0; k < 4; ++k)
+    {
+        flags[k] = static_cast<std::uint8_t>((((same >> k) & 1) ^ 1) * kLaneMoved | ((done >> k) & 1) * kLaneSettled);
+    }
+}
+
+UI_TARGET_SSE2 void EvaluateCurvesSse2(Easing easing, float now, const CurveBatch& batch)
+{
+    if (easing == Easing::Spring)
+    {
+        EvaluateCurvesScalar(easing, now, batch);
+        return;
+    }
+
+    const __m128 nowV = _mm_set1_ps(now);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 four = _mm_set1_ps(4.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    std::size_t i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        const __m128 elapsed = _mm_max_ps(_mm_sub_ps(nowV, _mm_loadu_ps(batch.starts + i)), zero);
+        const __m128 duration = _mm_loadu_ps(batch.durations + i);
+        const __m128 t = _mm_div_ps(elapsed, duration);
+
+        __m128 eased = t;
+        if (easing == Easing::Cubic)
+        {
+            const __m128 u = _mm_sub_ps(one, t);
+            const __m128 in = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(four, t), t), t);
+            const __m128 out = _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(four, u), u), u));
+            const __m128 first = _mm_cmplt_ps(t, half);
+            eased = _mm_or_ps(_mm_and_ps(first, in), _mm_andnot_ps(first, out));
+        }
+
+        const __m128 distance = _mm_loadu_ps(batch.distances + i);
+        const __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.froms + i));
+        const __m128i target = _mm_add_epi32(from, _mm_cvttps_epi32(distance));
+        const __m128i moving = _mm_add_epi32(from, RoundHalfAwaySse2(_mm_mul_ps(distance, eased)));
+        const __m128 settled = _mm_or_ps(_mm_cmpge_ps(elapsed, duration), _mm_castsi128_ps(_mm_cmpeq_epi32(moving, target)));
+        const __m128i settledInt = _mm_castps_si128(settled);
+        const __m128i next = _mm_or_si128(_mm_and_si128(settledInt, target), _mm_andnot_si128(settledInt, moving));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(batch.next + i), next);
+        StoreLaneFlagsSse2(batch.flags + i, next, _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.positions + i)), settled);
+    }
+    for (; i < batch.count; ++i)
+    {
+        CurveLaneScalar(easing, now, batch, i);
+    }
+}
+
+UI_TARGET_SSE2 void StepSpringsSse2(const SpringBatch& batch)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 euler = _mm_set1_ps(kE);
+    std::size_t i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(batch.offsets + i);
+        const __m128 w = _mm_loadu_ps(batch.omegas + i);
+        const __m128 e = _mm_loadu_ps(batch.decays + i);
+        const __m128 b = _mm_add_ps(_mm_loadu_ps(batch.velocities + i), _mm_mul_ps(w, x));
+        const __m128 moved = _mm_add_ps(x, _mm_mul_ps(b, _mm_loadu_ps(batch.steps + i)));
+        const __m128 offset = _mm_mul_ps(moved, e);
+        const __m128 velocity = _mm_mul_ps(_mm_sub_ps(b, _mm_mul_ps(w, moved)), e);
+        _mm_storeu_ps(batch.offsets + i, offset);
+        _mm_storeu_ps(batch.velocities + i, velocity);
+
+        const __m128 rest = _mm_loadu_ps(batch.restDistances + i);
+        const __m128 atRest =
+            _mm_and_ps(_mm_cmple_ps(_mm_andnot_ps(sign, offset), rest), _mm_cmple_ps(_mm_andnot_ps(sign, velocity), _mm_mul_ps(rest, w)));
+        const __m128 swing = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_andnot_ps(sign, offset), w), euler),
+            _mm_andnot_ps(sign, _mm_add_ps(velocity, _mm_mul_ps(w, offset))));
+        const __m128 settled = _mm_or_ps(atRest, _mm_cmplt_ps(swing, _mm_mul_ps(_mm_mul_ps(half, w), euler)));
+        const __m128i target = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.targets + i));
+        const __m128i moving = _mm_add_epi32(target, RoundHalfAwaySse2(offset));
+        const __m128i settledInt = _mm_castps_si128(settled);
+        const __m128i next = _mm_or_si128(_mm_and_si128(settledInt, target), _mm_andnot_si128(settledInt, moving));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(batch.next + i), next);
+        StoreLaneFlagsSse2(batch.flags + i, next, _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.positions + i)), settled);
+    }
+    for (; i < batch.count; ++i)
+    {
+        SpringLaneScalar(batch, i);
+    }
+}
+#endif
+
+#if defined(UI_ANIMATION_KERNELS_NEON)
+inline int32x4_t RoundHalfAwayNeon(float32x4_t value)
+{
+    const uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(value), vdupq_n_u32(0x80000000u));
+    const float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(sign, vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+    return vcvtq_s32_f32(vaddq_f32(value, half));
+}
+
+inline void StoreLaneFlagsNeon(std::uint8_t* flags, int32x4_t next, int32x4_t positions, uint32x4_t settled)
+{
+    std::uint32_t same[4];
+    std::uint32_t done[4];
+    vst1q_u32(same, vceqq_s32(next, positions));
+    vst1q_u32(done, settled);
+    for (int k = 0; k < 4; ++k)
+    {
+        flags[k] = static_cast<std::uint8_t>((same[k] == 0 ? kLaneMoved : 0) | (done[k] != 0 ? kLaneSettled : 0));
+    }
+}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+void EvaluateCurvesNeon(Easing easing, float now, const CurveBatch& batch)
+{
+    if (easing == Easing::Spring)
+    {
+        EvaluateCurvesScalar(easing, now, batch);
+        return;
+    }
+
+    const float32x4_t nowV = vdupq_n_f32(now);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t four = vdupq_n_f32(4.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    std::size_t i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        const float32x4_t elapsed = vmaxq_f32(vsubq_f32(nowV, vld1q_f32(batch.starts + i)), zero);
+        const float32x4_t duration = vld1q_f32(batch.durations + i);
+        const float32x4_t t = vdivq_f32(elapsed, duration);
+
+        float32x4_t eased = t;
+        if (easing == Easing::Cubic)
+        {
+            const float32x4_t u = vsubq_f32(one, t);
+            const float32x4_t in = vmulq_f32(vmulq_f32(vmulq_f32(four, t), t), t);
+            const float32x4_t out = vsubq_f32(one, vmulq_f32(vmulq_f32(vmulq_f32(four, u), u), u));
+            eased = vbslq_f32(vcltq_f32(t, half), in, out);
+        }
+
+        const float32x4_t distance = vld1q_f32(batch.distances + i);
+        const int32x4_t from = vld1q_s32(batch.froms + i);
+        const int32x4_t target = vaddq_s32(from, vcvtq_s32_f32(distance));
+        const int32x4_t moving = vaddq_s32(from, RoundHalfAwayNeon(vmulq_f32(distance, eased)));
+        const uint32x4_t settled = vorrq_u32(vcgeq_f32(elapsed, duration), vceqq_s32(moving, target));
+        const int32x4_t next = vbslq_s32(settled, target, moving);
+        vst1q_s32(batch.next + i, next);
+        StoreLaneFlagsNeon(batch.flags + i, next, vld1q_s32(batch.positions + i), settled);
+    }
+    for (; i < batch.count; ++i)
+    {
+        CurveLaneScalar(easing, now, batch, i);
+    }
+}
+#endif
+
+void StepSpringsNeon(const SpringBatch& batch)
+{
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t euler = vdupq_n_f32(kE);
+    std::size_t i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        const float32x4_t x = vld1q_f32(batch.offsets + i);
+        const float32x4_t w = vld1q_f32(batch.omegas + i);
+        const float32x4_t e = vld1q_f32(batch.decays + i);
+        const float32x4_t b = vaddq_f32(vld1q_f32(batch.velocities + i), vmulq_f32(w, x));
+        const float32x4_t moved = vaddq_f32(x, vmulq_f32(b, vld1q_f32(batch.steps + i)));
+        const float32x4_t offset = vmulq_f32(moved, e);
+        const float32x4_t velocity = vmulq_f32(vsubq_f32(b, vmulq_f32(w, moved)), e);
+        vst1q_f32(batch.offsets + i, offset);
+        vst1q_f32(batch.velocities + i, velocity);
+
+        const float32x4_t rest = vld1q_f32(batch.restDistances + i);
+        const uint32x4_t atRest = vandq_u32(vcleq_f32(vabsq_f32(offset), rest), vcleq_f32(vabsq_f32(velocity), vmulq_f32(rest, w)));
+        const float32x4_t swing =
+            vaddq_f32(vmulq_f32(vmulq_f32(vabsq_f32(offset), w), euler), vabsq_f32(vaddq_f32(velocity, vmulq_f32(w, offset))));
+        const uint32x4_t settled = vorrq_u32(atRest, vcltq_f32(swing, vmulq_f32(vmulq_f32(half, w), euler)));
+        const int32x4_t target = vld1q_s32(batch.targets + i);
+        const int32x4_t next = vbslq_s32(settled, target, vaddq_s32(target, RoundHalfAwayNeon(offset)));
+        vst1q_s32(batch.next + i, next);
+        StoreLaneFlagsNeon(batch.flags + i, next, vld1q_s32(batch.positions + i), settled);
+    }
+    for (; i < batch.count; ++i)
+    {
+        SpringLaneScalar(batch, i);
+    }
+}
+#endif
+
+CurveFn ResolveCurves(PixelKernel kernel)
+{
+    switch (kernel)
+    {
+#if defined(UI_ANIMATION_KERNELS_X86)
+        case PixelKernel::Sse2:
+        case PixelKernel::Avx2:
+            return EvaluateCurvesSse2;
+#endif
+#if defined(UI_ANIMATION_KERNELS_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+        case PixelKernel::Neon:
+            return EvaluateCurvesNeon;
+#endif
+        default:
+            return EvaluateCurvesScalar;
+    }
+}
+
+SpringFn ResolveSprings(PixelKernel kernel)
+{
+    switch (kernel)
+    {
+#if defined(UI_ANIMATION_KERNELS_X86)
+        case PixelKernel::Sse2:
+        case PixelKernel::Avx2:
+            return StepSpringsSse2;
+#endif
+#if defined(UI_ANIMATION_KERNELS_NEON)
+        case PixelKernel::Neon:
+            return StepSpringsNeon;
+#endif
+        default:
+            return StepSpringsScalar;
+    }
+}
+} // namespace
+
+void EvaluateCurves(Easing easing, float now, const CurveBatch& batch)
+{
+    static const CurveFn evaluate = ResolveCurves(ActivePixelKernel());
+    evaluate(easing, now, batch);
+}
+
+void StepSprings(const SpringBatch& batch)
+{
+    static const SpringFn step = ResolveSprings(ActivePixelKernel());
+    step(batch);
+}
+
+void EvaluateCurves(PixelKernel kernel, Easing easing, float now, const CurveBatch& batch)
+{
+    ResolveCurves(kernel)(easing, now, batch);
+}
+
+void StepSprings(PixelKernel kernel, const SpringBatch& batch)
+{
+    ResolveSprings(kernel)(batch);
+}
+} // namespace ui
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "AnimationScheduler.h"
+#include "PixelKernels.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Batched animation steps over parallel arrays, one lane per animation, several lanes per
+// SIMD instruction. Each kernel moves its lanes to the current time, rounds them to whole
+// pixels, compares them with the last reported positions and flags the lanes that moved or
+// settled, so the scheduler only touches those afterwards. Every kernel produces the same
+// positions and flags as the scalar one.
+namespace ui
+{
+enum AnimationLaneFlags : std::uint8_t
+{
+    kLaneMoved = 1,   // next differs from positions
+    kLaneSettled = 2, // next is the target and the animation is over
+};
+
+// Curve animations of one easing. Times are microseconds since the scheduler's epoch, held
+// in floats, which are exact below 2^24. A lane settles at its duration, or earlier on the
+// first evaluation from which its rounded position stays on the target.
+struct CurveBatch
+{
+    const float* starts;
+    const float* durations;
+    const std::int32_t* froms;
+    const float* distances; // target minus from
+    const std::int32_t* positions;
+    std::int32_t* next;
+    std::uint8_t* flags;
+    std::size_t count;
+};
+
+// Critically damped springs. The step is the exact solution of x'' = -w^2 x - 2w x',
+//   x(t) = (x0 + (v0 + w x0) t) e^(-w t),
+// so it is stable and frame-rate independent for any step size. offsets (position minus
+// target, in pixels) and velocities (pixels per second) are updated in place. steps are in
+// seconds and decays[i] = exp(-omegas[i] * steps[i]); the caller supplies the exponentials
+// because springs of one scheduler mostly share them. A lane settles once it is within
+// restDistances of its target and slower than restDistances * omegas pixels per second, or
+// as soon as its remaining swing is too small to move its rounded position off the target.
+struct SpringBatch
+{
+    float* offsets;
+    float* velocities;
+    const float* omegas;
+    const float* steps;
+    const float* decays;
+    const float* restDistances;
+    const std::int32_t* targets;
+    const std::int32_t* positions;
+    std::int32_t* next;
+    std::uint8_t* flags;
+    std::size_t count;
+};
+
+// Evaluates every lane of batch at now. Linear and cubic run in SIMD; the spring easing's
+// exponential and cosine are evaluated per lane.
+void EvaluateCurves(Easing easing, float now, const CurveBatch& batch);
+
+void StepSprings(const SpringBatch& batch);
+
+// Same steps forced through one kernel; the kernel must be supported. AVX2 runs the SSE2 code.
+void EvaluateCurves(PixelKernel kernel, Easing easing, float now, const CurveBatch& batch);
+void StepSprings(PixelKernel kernel, const SpringBatch& batch);
+} // namespace ui
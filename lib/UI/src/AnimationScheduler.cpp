@@ -0,0 +1,373 @@
+#include "AnimationScheduler.h"
+
+#include "AnimationKernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+namespace ui
+{
+namespace
+{
+// Curve times are kept relative to an epoch that moves up every few seconds while anything
+// animates, so they stay below 2^24 microseconds where floats count them exactly.
+constexpr std::uint64_t kRebaseMicroseconds = 1u << 22;
+
+// Decay rate of the spring easing's envelope, per unit of progress.
+constexpr double kSpringEasingDecay = 6.0;
+
+// Swaps the last lane into the gap so the arrays stay compact; order is not kept.
+template <typename Lane>
+void SwapRemove(std::vector<Lane>& lane, std::size_t index)
+{
+    lane[index] = lane.back();
+    lane.pop_back();
+}
+} // namespace
+
+std::uint64_t SteadyClockMicroseconds()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+float SpringFrequencyForSettleTime(std::uint64_t settleMicroseconds)
+{
+    // From rest the remaining distance is (1 + w t) e^(-w t), which is 0.3% at w t = 8.
+    return settleMicroseconds == 0 ? 0.0f : static_cast<float>(8.0e6 / static_cast<double>(settleMicroseconds));
+}
+
+double EaseProgress(Easing easing, double t)
+{
+    if (t <= 0.0)
+    {
+        return 0.0;
+    }
+    if (t >= 1.0)
+    {
+        return 1.0;
+    }
+
+    switch (easing)
+    {
+        case Easing::Cubic:
+            return t < 0.5 ? 4.0 * t * t * t : 1.0 - 4.0 * (1.0 - t) * (1.0 - t) * (1.0 - t);
+        case Easing::Spring:
+        {
+            // An underdamped step response: about 13% overshoot at t = 1/3, then 1.5
+            // oscillations decaying to within 0.3% of the target by t = 1.
+            const double pi = 3.14159265358979323846;
+            return 1.0 - std::exp(-kSpringEasingDecay * t) * std::cos(3.0 * pi * t);
+        }
+        case Easing::Linear:
+        default:
+            return t;
+    }
+}
+
+double EaseRemainingSwing(Easing easing, double t)
+{
+    if (t >= 1.0)
+    {
+        return 0.0;
+    }
+    // Linear and cubic only approach 1; the spring stays inside its decay envelope.
+    return easing == Easing::Spring ? std::exp(-kSpringEasingDecay * std::max(t, 0.0)) : 1.0 - EaseProgress(easing, t);
+}
+
+AnimationScheduler::AnimationScheduler(AnimationClock clock, std::function<void(bool)> setTicking)
+    : clock_(std::move(clock)), setTicking_(std::move(setTicking))
+{
+}
+
+void AnimationScheduler::Animate(void* owner, int from, int to, const AnimationCurve& curve)
+{
+    const bool wasTicking = IsTicking();
+    const std::uint64_t now = clock_();
+    if (!wasTicking)
+    {
+        epoch_ = now;
+    }
+
+    const std::uint8_t group = static_cast<std::uint8_t>(curve.easing);
+    const auto found = lanes_.find(owner);
+    if (found != lanes_.end() && (found->second.group != group || from == to))
+    {
+        Remove(owner);
+    }
+
+    if (from != to)
+    {
+        CurveLanes& lanes = curves_[group];
+        std::size_t lane = lanes.owners.size();
+        const auto existing = lanes_.find(owner);
+        if (existing != lanes_.end())
+        {
+            lane = existing->second.index;
+        }
+        else
+        {
+            lanes_.emplace(owner, LaneRef{group, static_cast<std::uint32_t>(lane)});
+            lanes.owners.push_back(owner);
+            lanes.starts.push_back(0.0f);
+            lanes.durations.push_back(0.0f);
+            lanes.froms.push_back(0);
+            lanes.distances.push_back(0.0f);
+            lanes.positions.push_back(0);
+            lanes.next.push_back(0);
+            lanes.flags.push_back(0);
+        }
+        lanes.starts[lane] = SinceEpoch(now);
+        lanes.durations[lane] = static_cast<float>(curve.durationMicroseconds);
+        lanes.froms[lane] = from;
+        lanes.distances[lane] = static_cast<float>(to - from);
+        lanes.positions[lane] = from;
+    }
+    NotifyTicking(wasTicking);
+}
+
+void AnimationScheduler::AnimateSpring(void* owner, int from, int to, const SpringParams& spring)
+{
+    const bool wasTicking = IsTicking();
+    const std::uint64_t now = clock_();
+    if (!wasTicking)
+    {
+        epoch_ = now;
+    }
+
+    const auto found = lanes_.find(owner);
+    if (found != lanes_.end() && found->second.group != kSpringGroup)
+    {
+        Remove(owner);
+    }
+
+    SpringLanes& lanes = springs_;
+    std::size_t lane = lanes.owners.size();
+    const auto existing = lanes_.find(owner);
+    if (existing != lanes_.end())
+    {
+        // Bring the spring up to now under its old parameters, then move only the target.
+        lane = existing->second.index;
+        lanes.steps[lane] = static_cast<float>(now > lanes.times[lane] ? now - lanes.times[lane] : 0) * 1.0e-6f;
+        lanes.decays[lane] = std::exp(-lanes.omegas[lane] * lanes.steps[lane]);
+        StepSprings(PixelKernel::Scalar, SpringBatch{&lanes.offsets[lane], &lanes.velocities[lane], &lanes.omegas[lane], &lanes.steps[lane],
+            &lanes.decays[lane], &lanes.restDistances[lane], &lanes.targets[lane], &lanes.positions[lane], &lanes.next[lane],
+            &lanes.flags[lane], 1});
+        lanes.offsets[lane] += static_cast<float>(lanes.targets[lane] - to);
+        lanes.targets[lane] = to;
+        lanes.times[lane] = now;
+    }
+    else if (from != to)
+    {
+        lanes_.emplace(owner, LaneRef{kSpringGroup, static_cast<std::uint32_t>(lane)});
+        lanes.owners.push_back(owner);
+        lanes.targets.push_back(to);
+        lanes.positions.push_back(from);
+        lanes.times.push_back(now);
+        lanes.offsets.push_back(static_cast<float>(from - to));
+        lanes.velocities.push_back(0.0f);
+        lanes.omegas.push_back(0.0f);
+        lanes.restDistances.push_back(0.0f);
+        lanes.steps.push_back(0.0f);
+        lanes.decays.push_back(1.0f);
+        lanes.next.push_back(0);
+        lanes.flags.push_back(0);
+    }
+
+    if (lane != lanes.owners.size())
+    {
+        lanes.omegas[lane] = spring.angularFrequency;
+        lanes.restDistances[lane] = spring.restDistance;
+    }
+    NotifyTicking(wasTicking);
+}
+
+void AnimationScheduler::Cancel(void* owner)
+{
+    const bool wasTicking = IsTicking();
+    Remove(owner);
+    NotifyTicking(wasTicking);
+}
+
+const std::vector<AnimationUpdate>& AnimationScheduler::Tick()
+{
+    const bool wasTicking = IsTicking();
+    updates_.clear();
+    const std::uint64_t now = clock_();
+    if (now > epoch_ + kRebaseMicroseconds)
+    {
+        Rebase(now);
+    }
+
+    const float sinceEpoch = SinceEpoch(now);
+    for (std::uint8_t group = 0; group < kSpringGroup; ++group)
+    {
+        TickCurves(group, sinceEpoch);
+    }
+    TickSprings(now);
+    ++stats_.ticks;
+    stats_.idleTicks += updates_.empty() ? 1 : 0;
+    stats_.moves += updates_.size();
+    NotifyTicking(wasTicking);
+    return updates_;
+}
+
+// Moves the epoch up to now so curve times stay small enough for floats to hold exactly.
+void AnimationScheduler::Rebase(std::uint64_t now)
+{
+    const float shift = SinceEpoch(now);
+    for (CurveLanes& lanes : curves_)
+    {
+        for (float& start : lanes.starts)
+        {
+            start -= shift;
+        }
+    }
+    epoch_ = now;
+}
+
+// Evaluates one easing's lanes in a single kernel pass, then visits only the lanes it flagged:
+// those that moved are reported and those that settled leave the group.
+void AnimationScheduler::TickCurves(std::uint8_t group, float now)
+{
+    CurveLanes& lanes = curves_[group];
+    if (lanes.owners.empty())
+    {
+        return;
+    }
+
+    EvaluateCurves(static_cast<Easing>(group), now,
+        CurveBatch{lanes.starts.data(), lanes.durations.data(), lanes.froms.data(), lanes.distances.data(), lanes.positions.data(),
+            lanes.next.data(), lanes.flags.data(), lanes.owners.size()});
+
+    // Backwards, so a settled lane is replaced by one already visited.
+    for (std::size_t i = lanes.owners.size(); i-- > 0;)
+    {
+        const std::uint8_t flags = lanes.flags[i];
+        if ((flags & kLaneMoved) != 0)
+        {
+            updates_.push_back(AnimationUpdate{lanes.owners[i], lanes.positions[i], lanes.next[i], (flags & kLaneSettled) != 0});
+            lanes.positions[i] = lanes.next[i];
+        }
+        if ((flags & kLaneSettled) != 0)
+        {
+            ++stats_.settled;
+            RemoveCurveAt(group, i);
+        }
+    }
+}
+
+// Steps every spring to now in one kernel pass and handles the flagged lanes as TickCurves does.
+void AnimationScheduler::TickSprings(std::uint64_t now)
+{
+    SpringLanes& lanes = springs_;
+    const std::size_t count = lanes.owners.size();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Springs share their step and mostly their stiffness, so the exponential is computed
+    // once per run of equal lanes rather than once per lane.
+    float lastOmega = -1.0f;
+    float lastStep = -1.0f;
+    float lastDecay = 1.0f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float step = static_cast<float>(now > lanes.times[i] ? now - lanes.times[i] : 0) * 1.0e-6f;
+        if (lanes.omegas[i] != lastOmega || step != lastStep)
+        {
+            lastOmega = lanes.omegas[i];
+            lastStep = step;
+            lastDecay = std::exp(-lastOmega * step);
+        }
+        lanes.steps[i] = step;
+        lanes.decays[i] = lastDecay;
+        lanes.times[i] = now;
+    }
+    StepSprings(SpringBatch{lanes.offsets.data(), lanes.velocities.data(), lanes.omegas.data(), lanes.steps.data(), lanes.decays.data(),
+        lanes.restDistances.data(), lanes.targets.data(), lanes.positions.data(), lanes.next.data(), lanes.flags.data(), count});
+
+    for (std::size_t i = count; i-- > 0;)
+    {
+        const std::uint8_t flags = lanes.flags[i];
+        if ((flags & kLaneMoved) != 0)
+        {
+            updates_.push_back(AnimationUpdate{lanes.owners[i], lanes.positions[i], lanes.next[i], (flags & kLaneSettled) != 0});
+            lanes.positions[i] = lanes.next[i];
+        }
+        if ((flags & kLaneSettled) != 0)
+        {
+            ++stats_.settled;
+            RemoveSpringAt(i);
+        }
+    }
+}
+
+void AnimationScheduler::Remove(void* owner)
+{
+    const auto found = lanes_.find(owner);
+    if (found == lanes_.end())
+    {
+        return;
+    }
+    if (found->second.group == kSpringGroup)
+    {
+        RemoveSpringAt(found->second.index);
+    }
+    else
+    {
+        RemoveCurveAt(found->second.group, found->second.index);
+    }
+}
+
+void AnimationScheduler::RemoveCurveAt(std::uint8_t group, std::size_t index)
+{
+    CurveLanes& lanes = curves_[group];
+    lanes_.erase(lanes.owners[index]);
+    if (index + 1 != lanes.owners.size())
+    {
+        lanes_[lanes.owners.back()].index = static_cast<std::uint32_t>(index);
+    }
+    SwapRemove(lanes.owners, index);
+    SwapRemove(lanes.starts, index);
+    SwapRemove(lanes.durations, index);
+    SwapRemove(lanes.froms, index);
+    SwapRemove(lanes.distances, index);
+    SwapRemove(lanes.positions, index);
+    SwapRemove(lanes.next, index);
+    SwapRemove(lanes.flags, index);
+}
+
+void AnimationScheduler::RemoveSpringAt(std::size_t index)
+{
+    SpringLanes& lanes = springs_;
+    lanes_.erase(lanes.owners[index]);
+    if (index + 1 != lanes.owners.size())
+    {
+        lanes_[lanes.owners.back()].index = static_cast<std::uint32_t>(index);
+    }
+    SwapRemove(lanes.owners, index);
+    SwapRemove(lanes.targets, index);
+    SwapRemove(lanes.positions, index);
+    SwapRemove(lanes.times, index);
+    SwapRemove(lanes.offsets, index);
+    SwapRemove(lanes.velocities, index);
+    SwapRemove(lanes.omegas, index);
+    SwapRemove(lanes.restDistances, index);
+    SwapRemove(lanes.steps, index);
+    SwapRemove(lanes.decays, index);
+    SwapRemove(lanes.next, index);
+    SwapRemove(lanes.flags, index);
+}
+
+void AnimationScheduler::NotifyTicking(bool wasTicking)
+{
+    if (wasTicking != IsTicking() && setTicking_)
+    {
+        setTicking_(!wasTicking);
+    }
+}
+} // namespace ui
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// One scheduler drives every animating control of a UI thread from a single periodic tick.
+// It keeps only the animating controls, as structure-of-arrays lanes grouped by kind, steps
+// each group per tick in one pass of a SIMD kernel (AnimationKernels.h), and reports only
+// the controls whose whole-pixel position changed. It asks the host to stop ticking once the
+// last one settles. Curve animations run for a fixed duration; springs run until at rest. The platform layer
+// supplies the tick; nothing here knows about windows or timers, so it runs under a virtual
+// clock as well. Not thread-safe: a scheduler belongs to one thread.
+namespace ui
+{
+// Monotonic time in microseconds.
+using AnimationClock = std::function<std::uint64_t()>;
+
+// std::chrono::steady_clock in microseconds; the default clock.
+std::uint64_t SteadyClockMicroseconds();
+
+enum class Easing : std::uint8_t
+{
+    Linear,
+    Cubic,  // ease-in-out
+    Spring, // overshoots the target and rings down onto it
+};
+
+// How a value travels: the easing applied to its progress, and the time the whole move takes.
+struct AnimationCurve
+{
+    Easing easing = Easing::Linear;
+    std::uint64_t durationMicroseconds = 0;
+};
+
+// A critically damped spring: from rest it closes on the target as fast as it can without
+// overshooting. It carries its velocity through retargets, so a reversal mid-flight slows,
+// turns and comes back instead of jumping to a new speed.
+struct SpringParams
+{
+    float angularFrequency = 0.0f; // radians per second; higher is stiffer
+    float restDistance = 0.25f;    // pixels; see AnimationScheduler::AnimateSpring
+};
+
+// Angular frequency of a spring that, started at rest, comes within 0.3% of its distance
+// after settleMicroseconds.
+float SpringFrequencyForSettleTime(std::uint64_t settleMicroseconds);
+
+// Eased progress at t in [0, 1]: 0 at 0 and exactly 1 at 1. Spring rises above 1 on the way.
+double EaseProgress(Easing easing, double t);
+
+// Bound on |EaseProgress(easing, u) - 1| for every u >= t. Once distance times this is under
+// half a pixel the rounded position can no longer leave the target.
+double EaseRemainingSwing(Easing easing, double t);
+
+// An animated value that moved during a tick. settled is set when the move ends the
+// animation, which is then no longer scheduled.
+struct AnimationUpdate
+{
+    void* owner;
+    int previous;
+    int current;
+    bool settled;
+};
+
+// Running totals of a scheduler, for measuring what animation costs while nothing moves.
+struct AnimationStats
+{
+    std::uint64_t ticks = 0;
+    std::uint64_t idleTicks = 0; // ticks that moved nothing by a whole pixel
+    std::uint64_t moves = 0;     // updates reported
+    std::uint64_t settled = 0;   // animations that reached their targets
+};
+
+class AnimationScheduler
+{
+public:
+    // setTicking(true) is called when the first animation starts and setTicking(false) when
+    // the last one settles or is cancelled.
+    AnimationScheduler(AnimationClock clock, std::function<void(bool)> setTicking);
+
+    AnimationScheduler(const AnimationScheduler&) = delete;
+    AnimationScheduler& operator=(const AnimationScheduler&) = delete;
+
+    // Moves owner's value from `from` to `to` along curve, starting now. An owner that is
+    // already animating is retargeted from `from`. Nothing is scheduled when from == to.
+    void Animate(void* owner, int from, int to, const AnimationCurve& curve);
+
+    // Moves owner's value toward `to` on a spring. An owner already on a spring keeps its
+    // position and velocity and only changes target; any other starts at `from`, at rest. The
+    // spring settles on `to` once it is within spring.restDistance of it and moving slower
+    // than restDistance * angularFrequency pixels per second.
+    void AnimateSpring(void* owner, int from, int to, const SpringParams& spring);
+
+    // Drops owner's animation, if any, leaving its value where the last tick put it.
+    void Cancel(void* owner);
+
+    // Sets every animation to where its curve is at the clock's current time and returns those
+    // that moved, valid until the next call. Positions depend only on the time, so a late
+    // tick skips ahead instead of stretching the animation. An animation settles on the first
+    // tick from which its whole-pixel position can no longer change, which may be before its
+    // duration ends, and leaves the active list; the host is told to stop ticking in that
+    // same call, so no tick is spent only discovering that a knob has arrived.
+    const std::vector<AnimationUpdate>& Tick();
+
+    const AnimationStats& Stats() const
+    {
+        return stats_;
+    }
+
+    std::size_t ActiveCount() const
+    {
+        return lanes_.size();
+    }
+
+    bool IsTicking() const
+    {
+        return ActiveCount() != 0;
+    }
+
+private:
+    // Curve animations of one easing, in parallel arrays for the batched kernels. Times are
+    // microseconds since epoch_, held in floats.
+    struct CurveLanes
+    {
+        std::vector<void*> owners;
+        std::vector<float> starts;
+        std::vector<float> durations;
+        std::vector<std::int32_t> froms;
+        std::vector<float> distances;
+        std::vector<std::int32_t> positions; // last reported
+        std::vector<std::int32_t> next;      // per-tick scratch
+        std::vector<std::uint8_t> flags;     // per-tick scratch
+    };
+
+    // Springs in parallel arrays. offsets are relative to the target and valid at times.
+    struct SpringLanes
+    {
+        std::vector<void*> owners;
+        std::vector<std::int32_t> targets;
+        std::vector<std::int32_t> positions; // last reported
+        std::vector<std::uint64_t> times;
+        std::vector<float> offsets;
+        std::vector<float> velocities;
+        std::vector<float> omegas;
+        std::vector<float> restDistances;
+        std::vector<float> steps;          // per-tick scratch
+        std::vector<float> decays;         // per-tick scratch
+        std::vector<std::int32_t> next;    // per-tick scratch
+        std::vector<std::uint8_t> flags;   // per-tick scratch
+    };
+
+    // Where an owner's animation lives: curves_[group], or springs_ for kSpringGroup.
+    struct LaneRef
+    {
+        std::uint8_t group;
+        std::uint32_t index;
+    };
+
+    static constexpr std::uint8_t kSpringGroup = 3;
+
+    float SinceEpoch(std::uint64_t time) const
+    {
+        return static_cast<float>(static_cast<double>(time) - static_cast<double>(epoch_));
+    }
+
+    void Rebase(std::uint64_t now);
+    void Remove(void* owner);
+    void RemoveCurveAt(std::uint8_t group, std::size_t index);
+    void RemoveSpringAt(std::size_t index);
+    void TickCurves(std::uint8_t group, float now);
+    void TickSprings(std::uint64_t now);
+
+    // Tells the host to start or stop ticking when a change crossed between idle and busy.
+    void NotifyTicking(bool wasTicking);
+
+    AnimationClock clock_;
+    std::function<void(bool)> setTicking_;
+    std::uint64_t epoch_ = 0;
+    CurveLanes curves_[3]; // indexed by Easing
+    SpringLanes springs_;
+    std::unordered_map<void*, LaneRef> lanes_;
+    std::vector<AnimationUpdate> updates_;
+    AnimationStats stats_;
+};
+} // namespace ui
@@ -0,0 +1,73 @@
+#include "Atlas.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ui
+{
+std::vector<TileRect> BuildTileGrid(int atlasWidth, int atlasHeight, int columns, int rows)
+{
+    std::vector<TileRect> tiles;
+    if (columns <= 0 || rows <= 0)
+    {
+        return tiles;
+    }
+
+    const int tileWidth = atlasWidth / columns;
+    const int tileHeight = atlasHeight / rows;
+    tiles.reserve(static_cast<std::size_t>(columns * rows));
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int col = 0; col < columns; ++col)
+        {
+            tiles.push_back(TileRect{col * tileWidth, row * tileHeight, tileWidth, tileHeight});
+        }
+    }
+
+    return tiles;
+}
+
+TileRect ComputeVisibleBounds(const unsigned char* pixels, int atlasWidth, const TileRect& tile)
+{
+    int minX = tile.width;
+    int minY = tile.height;
+    int maxX = 0;
+    int maxY = 0;
+    bool hasVisiblePixel = false;
+
+    for (int y = 0; y < tile.height; ++y)
+    {
+        const unsigned char* row = pixels + (static_cast<std::size_t>(tile.y + y) * atlasWidth + tile.x) * 4;
+        for (int x = 0; x < tile.width; ++x)
+        {
+            if (row[x * 4 + 3] > 0)
+            {
+                hasVisiblePixel = true;
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+        }
+    }
+
+    if (!hasVisiblePixel)
+    {
+        return tile;
+    }
+
+    return TileRect{tile.x + minX, tile.y + minY, maxX - minX + 1, maxY - minY + 1};
+}
+
+std::vector<TileRect> ComputeVisibleBoundsTable(const unsigned char* pixels, int atlasWidth, const std::vector<TileRect>& tiles)
+{
+    std::vector<TileRect> bounds;
+    bounds.reserve(tiles.size());
+    for (const TileRect& tile : tiles)
+    {
+        bounds.push_back(ComputeVisibleBounds(pixels, atlasWidth, tile));
+    }
+    return bounds;
+}
+} // namespace ui
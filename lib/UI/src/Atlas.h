@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+// Platform-neutral atlas helpers shared by the Win32 control, tools and benchmarks.
+namespace ui
+{
+struct TileRect
+{
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+// Grid layout of one hand-authored atlas, keyed by its file stem in assets/Troggle.
+struct AtlasLayout
+{
+    const char* name;
+    int columns;
+    int rows;
+};
+
+constexpr AtlasLayout kBodyAtlasLayout{"switch-body", 5, 2};
+constexpr AtlasLayout kSwitchAtlasLayout{"Switch", 3, 2};
+
+// Splits an atlas into a uniform columns x rows grid, row-major.
+std::vector<TileRect> BuildTileGrid(int atlasWidth, int atlasHeight, int columns, int rows);
+
+// Returns the smallest rectangle of a tile containing a non-zero alpha pixel, in atlas
+// coordinates. Fully transparent tiles return the whole tile. Pixels are 32-bit with alpha last.
+TileRect ComputeVisibleBounds(const unsigned char* pixels, int atlasWidth, const TileRect& tile);
+
+// Computes ComputeVisibleBounds for every tile, index-aligned with tiles.
+std::vector<TileRect> ComputeVisibleBoundsTable(const unsigned char* pixels, int atlasWidth, const std::vector<TileRect>& tiles);
+} // namespace ui
@@ -0,0 +1,296 @@
+#include "AtlasFile.h"
+
+#include "AtlasPacker.h"
+#include "PixelKernels.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ui
+{
+namespace
+{
+static_assert(sizeof(AtlasFileHeader) == 56, "AtlasFileHeader layout is part of the file format");
+static_assert(sizeof(TileRect) == 16, "TileRect layout is part of the file format");
+
+std::uint32_t AlignUp(std::uint32_t value, std::uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Written so that no sum of untrusted fields can overflow.
+bool TileInside(const TileRect& tile, int width, int height)
+{
+    return tile.x >= 0 && tile.y >= 0 && tile.width >= 0 && tile.height >= 0 &&
+        tile.x <= width && tile.y <= height && tile.width <= width - tile.x && tile.height <= height - tile.y;
+}
+} // namespace
+
+// FNV-1a over 32-bit words (trailing bytes folded in one at a time).
+std::uint32_t ComputeAtlasChecksum(const unsigned char* data, std::size_t size)
+{
+    std::uint32_t hash = 2166136261u;
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        std::uint32_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 16777619u;
+    }
+    for (; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+std::vector<unsigned char> SerializeAtlasFile(
+    int sourceWidth,
+    int sourceHeight,
+    int columns,
+    int rows,
+    const std::vector<TileRect>& tiles,
+    const std::vector<TileRect>& visibleBounds,
+    int width,
+    int height,
+    const std::vector<TileRect>& packedBounds,
+    const unsigned char* pixels)
+{
+    if (tiles.size() != visibleBounds.size() || tiles.size() != packedBounds.size())
+    {
+        throw std::runtime_error("Tile and bounds tables differ in size");
+    }
+
+    AtlasFileHeader header{};
+    header.magic = kAtlasFileMagic;
+    header.version = kAtlasFileVersion;
+    header.width = width;
+    header.height = height;
+    header.columns = columns;
+    header.rows = rows;
+    header.tileCount = static_cast<std::uint32_t>(tiles.size());
+    header.tableOffset = sizeof(AtlasFileHeader);
+    header.sourceWidth = sourceWidth;
+    header.sourceHeight = sourceHeight;
+
+    const std::uint32_t tableBytes = header.tileCount * static_cast<std::uint32_t>(sizeof(TileRect));
+    header.pixelOffset = AlignUp(header.tableOffset + tableBytes * 3, kAtlasFilePixelAlignment);
+    header.pixelBytes = static_cast<std::uint32_t>(width) * static_cast<std::uint32_t>(height) * 4;
+
+    std::vector<unsigned char> bytes(header.pixelOffset + header.pixelBytes, 0);
+    std::memcpy(&bytes[header.tableOffset], tiles.data(), tableBytes);
+    std::memcpy(&bytes[header.tableOffset + tableBytes], visibleBounds.data(), tableBytes);
+    std::memcpy(&bytes[header.tableOffset + tableBytes * 2], packedBounds.data(), tableBytes);
+    std::memcpy(&bytes[header.pixelOffset], pixels, header.pixelBytes);
+
+    header.checksum = ComputeAtlasChecksum(bytes.data() + sizeof(AtlasFileHeader), bytes.size() - sizeof(AtlasFileHeader));
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    return bytes;
+}
+
+std::vector<unsigned char> BakeAtlasFile(const unsigned char* rgbaPixels, int width, int height, const AtlasLayout& layout)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+    PremultiplyRgbaToBgraRows(rgbaPixels, pixels.data(), width, height);
+
+    const std::vector<TileRect> tiles = BuildTileGrid(width, height, layout.columns, layout.rows);
+    const std::vector<TileRect> visibleBounds = ComputeVisibleBoundsTable(pixels.data(), width, tiles);
+    const PackedAtlas packed = PackVisibleTiles(pixels.data(), width, visibleBounds);
+    return SerializeAtlasFile(
+        width, height, layout.columns, layout.rows, tiles, visibleBounds, packed.width, packed.height, packed.packedBounds, packed.pixels.data());
+}
+
+AtlasFileView ParseAtlasFile(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (bytes == nullptr || size < sizeof(AtlasFileHeader))
+    {
+        throw std::runtime_error("Atlas file is truncated");
+    }
+
+    AtlasFileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != kAtlasFileMagic || header.version != kAtlasFileVersion)
+    {
+        throw std::runtime_error("Not a supported atlas file");
+    }
+
+    const std::uint64_t tableBytes = static_cast<std::uint64_t>(header.tileCount) * sizeof(TileRect);
+    const std::uint64_t expectedPixelBytes = static_cast<std::uint64_t>(header.width) * static_cast<std::uint64_t>(header.height) * 4;
+    if (header.width <= 0 || header.height <= 0 || header.sourceWidth <= 0 || header.sourceHeight <= 0 ||
+        header.columns <= 0 || header.rows <= 0 ||
+        header.tileCount != static_cast<std::uint64_t>(header.columns) * static_cast<std::uint64_t>(header.rows) ||
+        header.tableOffset != sizeof(AtlasFileHeader) ||
+        header.tableOffset + tableBytes * 3 > header.pixelOffset ||
+        header.pixelOffset % kAtlasFilePixelAlignment != 0 ||
+        header.pixelBytes != expectedPixelBytes ||
+        static_cast<std::uint64_t>(header.pixelOffset) + header.pixelBytes > size)
+    {
+        throw std::runtime_error("Atlas file header is inconsistent");
+    }
+
+    if (ComputeAtlasChecksum(bytes + sizeof(AtlasFileHeader), size - sizeof(AtlasFileHeader)) != header.checksum)
+    {
+        throw std::runtime_error("Atlas file checksum mismatch");
+    }
+
+    AtlasFileView view;
+    view.width = header.width;
+    view.height = header.height;
+    view.columns = header.columns;
+    view.rows = header.rows;
+    view.sourceWidth = header.sourceWidth;
+    view.sourceHeight = header.sourceHeight;
+    view.tileCount = static_cast<int>(header.tileCount);
+    view.tiles = reinterpret_cast<const TileRect*>(bytes + header.tableOffset);
+    view.visibleBounds = view.tiles + header.tileCount;
+    view.packedBounds = view.visibleBounds + header.tileCount;
+    view.pixels = bytes + header.pixelOffset;
+    view.pixelOffset = header.pixelOffset;
+
+    for (int i = 0; i < view.tileCount; ++i)
+    {
+        const TileRect& visible = view.visibleBounds[i];
+        const TileRect& packed = view.packedBounds[i];
+        if (!TileInside(view.tiles[i], view.sourceWidth, view.sourceHeight) || !TileInside(visible, view.sourceWidth, view.sourceHeight) ||
+            !TileInside(packed, view.width, view.height) || packed.width != visible.width || packed.height != visible.height)
+        {
+            throw std::runtime_error("Atlas file tile lies outside the image");
+        }
+    }
+
+    return view;
+}
+
+void WriteAtlasFile(const std::string& path, const std::vector<unsigned char>& bytes)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        throw std::runtime_error("Failed to open " + path + " for writing");
+    }
+
+    const std::size_t written = std::fwrite(bytes.data(), 1, bytes.size(), file);
+    const bool closed = std::fclose(file) == 0;
+    if (written != bytes.size() || !closed)
+    {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+#if defined(_WIN32)
+MappedFile::MappedFile(const std::string& path)
+{
+    const int chars = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(static_cast<std::size_t>(chars > 0 ? chars : 1), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], chars);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open " + path);
+    }
+
+    LARGE_INTEGER fileSize{};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+
+    if (mapping == nullptr)
+    {
+        throw std::runtime_error("Failed to map " + path);
+    }
+
+    data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (data_ == nullptr)
+    {
+        throw std::runtime_error("Failed to map " + path);
+    }
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+void MappedFile::Release()
+{
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+#else
+MappedFile::MappedFile(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open " + path);
+    }
+
+    struct stat info{};
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (mapped == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map " + path);
+    }
+
+    data_ = static_cast<const unsigned char*>(mapped);
+    size_ = static_cast<std::size_t>(info.st_size);
+}
+
+void MappedFile::Release()
+{
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    Release();
+}
+} // namespace ui
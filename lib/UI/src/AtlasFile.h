@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Atlas.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Baked runtime atlas container (.tglatlas). Layout, little-endian:
+//   AtlasFileHeader
+//   TileRect tiles[tileCount]          grid of the authored image (sourceWidth x sourceHeight)
+//   TileRect visibleBounds[tileCount]  visible part of each tile, authored image coordinates
+//   TileRect packedBounds[tileCount]   where that visible part is stored in the pixels
+//   zero padding up to pixelOffset (a multiple of kAtlasFilePixelAlignment)
+//   premultiplied BGRA pixels, width * height * 4 bytes, rows tightly packed
+// The pixels hold only the visible parts, repacked (AtlasPacker.h). The checksum covers every
+// byte after the header.
+namespace ui
+{
+constexpr std::uint32_t kAtlasFileMagic = 0x414C4754; // TGLA
+constexpr std::uint32_t kAtlasFileVersion = 2;
+constexpr std::uint32_t kAtlasFilePixelAlignment = 64;
+
+struct AtlasFileHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t columns;
+    std::int32_t rows;
+    std::uint32_t tileCount;
+    std::uint32_t tableOffset;
+    std::uint32_t pixelOffset;
+    std::uint32_t pixelBytes;
+    std::uint32_t checksum;
+    std::int32_t sourceWidth;
+    std::int32_t sourceHeight;
+    std::uint32_t reserved;
+};
+
+// Read-only view of a parsed atlas; all pointers alias the buffer it was parsed from.
+struct AtlasFileView
+{
+    int width = 0;
+    int height = 0;
+    int columns = 0;
+    int rows = 0;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    int tileCount = 0;
+    const TileRect* tiles = nullptr;
+    const TileRect* visibleBounds = nullptr;
+    const TileRect* packedBounds = nullptr;
+    const unsigned char* pixels = nullptr;
+    std::uint32_t pixelOffset = 0;
+};
+
+std::uint32_t ComputeAtlasChecksum(const unsigned char* data, std::size_t size);
+
+// Builds the file image for a converted atlas: tiles and visibleBounds describe the authored
+// sourceWidth x sourceHeight image, packedBounds the width x height pixels, which must
+// already be premultiplied BGRA.
+std::vector<unsigned char> SerializeAtlasFile(
+    int sourceWidth,
+    int sourceHeight,
+    int columns,
+    int rows,
+    const std::vector<TileRect>& tiles,
+    const std::vector<TileRect>& visibleBounds,
+    int width,
+    int height,
+    const std::vector<TileRect>& packedBounds,
+    const unsigned char* pixels);
+
+// Converts a straight-alpha RGBA image into a complete baked atlas: premultiply/swizzle,
+// tile grid and visible bounds, repacking, then SerializeAtlasFile.
+std::vector<unsigned char> BakeAtlasFile(const unsigned char* rgbaPixels, int width, int height, const AtlasLayout& layout);
+
+// Validates structure and checksum without copying. Throws std::runtime_error when invalid.
+AtlasFileView ParseAtlasFile(const void* data, std::size_t size);
+
+void WriteAtlasFile(const std::string& path, const std::vector<unsigned char>& bytes);
+
+// Read-only memory mapping of a whole file. Move-only; unmaps on destruction.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    // Maps path (UTF-8). Throws std::runtime_error when the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    const unsigned char* data() const
+    {
+        return data_;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    void Release();
+
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+} // namespace ui
@@ -0,0 +1,142 @@
+#include "AtlasLoader.h"
+
+#include "AtlasPacker.h"
+#include "ImageDecode.h"
+#include "Parallel.h"
+#include "PixelKernels.h"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace ui
+{
+namespace
+{
+bool FileExists(const std::string& path)
+{
+#if defined(_WIN32)
+    const int chars = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::wstring widePath(static_cast<std::size_t>(chars > 0 ? chars : 1), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], chars);
+    return GetFileAttributesW(widePath.c_str()) != INVALID_FILE_ATTRIBUTES;
+#else
+    struct stat info{};
+    return stat(path.c_str(), &info) == 0;
+#endif
+}
+
+// stb_image decodes straight into a buffer, one in-place pass premultiplies alpha and
+// swizzles to BGRA, and the visible parts are repacked into the atlas, as a bake would.
+ImageAtlas LoadPngAtlas(const std::string& path, const AtlasLayout& layout)
+{
+    int width = 0;
+    int height = 0;
+    ReadImageSize(path.c_str(), width, height);
+    std::vector<unsigned char> image(static_cast<std::size_t>(width) * height * 4);
+    DecodeRgbaInto(path.c_str(), image.data(), width, height);
+    PremultiplyRgbaToBgraRows(image.data(), image.data(), width, height);
+
+    ImageAtlas atlas;
+    atlas.tiles = BuildTileGrid(width, height, layout.columns, layout.rows);
+    atlas.visibleBounds = ComputeVisibleBoundsTable(image.data(), width, atlas.tiles);
+
+    PackedAtlas packed = PackVisibleTiles(image.data(), width, atlas.visibleBounds);
+    atlas.width = packed.width;
+    atlas.height = packed.height;
+    atlas.packedBounds = std::move(packed.packedBounds);
+    atlas.decoded = std::move(packed.pixels);
+    atlas.pixels = atlas.decoded.data();
+    return atlas;
+}
+} // namespace
+
+ImageAtlas LoadAtlasFromBakedImage(const void* data, std::size_t size, const AtlasLayout& layout)
+{
+    const AtlasFileView baked = ParseAtlasFile(data, size);
+    if (baked.columns != layout.columns || baked.rows != layout.rows)
+    {
+        throw std::runtime_error("Baked atlas has an unexpected tile layout");
+    }
+
+    ImageAtlas atlas;
+    atlas.width = baked.width;
+    atlas.height = baked.height;
+    atlas.tiles.assign(baked.tiles, baked.tiles + baked.tileCount);
+    atlas.visibleBounds.assign(baked.visibleBounds, baked.visibleBounds + baked.tileCount);
+    atlas.packedBounds.assign(baked.packedBounds, baked.packedBounds + baked.tileCount);
+    atlas.pixels = baked.pixels;
+    return atlas;
+}
+
+ImageAtlas LoadAtlasFromDirectory(const std::string& directory, const AtlasLayout& layout)
+{
+    const std::string basePath = directory + "/" + layout.name;
+    const std::string bakedPath = basePath + ".tglatlas";
+    if (!FileExists(bakedPath))
+    {
+        return LoadPngAtlas(basePath + ".png", layout);
+    }
+
+    // A baked file that cannot be used (stale layout, damaged, unmappable) is not fatal while
+    // its source image is there.
+    try
+    {
+        MappedFile mapping(bakedPath);
+        ImageAtlas atlas = LoadAtlasFromBakedImage(mapping.data(), mapping.size(), layout);
+        atlas.mapping = std::move(mapping);
+        return atlas;
+    }
+    catch (const std::runtime_error&)
+    {
+        return LoadPngAtlas(basePath + ".png", layout);
+    }
+}
+
+void BuildMipChains(ImageAtlas& atlas)
+{
+    const ImageView source{atlas.pixels, atlas.width, atlas.height, atlas.width * 4};
+    atlas.mips.clear();
+    atlas.mips.reserve(atlas.packedBounds.size());
+    for (const TileRect& bounds : atlas.packedBounds)
+    {
+        atlas.mips.push_back(BuildMipChain(source, bounds));
+    }
+}
+
+void CompressAtlas(ImageAtlas& atlas)
+{
+    const ImageView source{atlas.pixels, atlas.width, atlas.height, atlas.width * 4};
+    atlas.compressed.clear();
+    atlas.compressed.reserve(atlas.packedBounds.size());
+    for (const TileRect& bounds : atlas.packedBounds)
+    {
+        atlas.compressed.push_back(CompressTile(source, bounds));
+    }
+
+    atlas.pixels = nullptr;
+    std::vector<unsigned char>().swap(atlas.decoded);
+    atlas.mapping = MappedFile();
+}
+
+std::unique_ptr<ToggleAtlases> LoadToggleAtlases(const std::function<ImageAtlas(const AtlasLayout&)>& loadAtlas)
+{
+    const AtlasLayout layouts[] = {kBodyAtlasLayout, kSwitchAtlasLayout};
+    ImageAtlas loaded[sizeof(layouts) / sizeof(layouts[0])];
+    ParallelFor(sizeof(layouts) / sizeof(layouts[0]), [&](std::size_t i) {
+        loaded[i] = loadAtlas(layouts[i]);
+        BuildMipChains(loaded[i]);
+        CompressAtlas(loaded[i]);
+    });
+
+    std::unique_ptr<ToggleAtlases> atlases(new ToggleAtlases());
+    atlases->body = std::move(loaded[0]);
+    atlases->knob = std::move(loaded[1]);
+    return atlases;
+}
+} // namespace ui
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Atlas.h"
+#include "AtlasFile.h"
+#include "Resample.h"
+#include "RleTile.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Runtime atlas loading shared by every rendering backend.
+namespace ui
+{
+// An atlas' premultiplied BGRA pixels (rows tightly packed) with its tile tables, held in
+// whichever storage its source needs: a decoded PNG buffer, a read-only mapping of a baked
+// file, or caller-owned baked data such as the embedded images. Move-only.
+//
+// The pixels are repacked (AtlasPacker.h): they hold only each tile's visible part, at
+// packedBounds. tiles and visibleBounds keep the authored image's coordinates, so
+// visibleBounds[i] - tiles[i] is the offset of the visible part within its tile.
+//
+// CompressAtlas replaces the pixels with one RleTile per visible part and releases them;
+// rendering draws from the compressed tiles and the mip chains only.
+struct ImageAtlas
+{
+    int width = 0; // of pixels, not of the authored image
+    int height = 0;
+    const unsigned char* pixels = nullptr; // null once compressed
+    std::vector<TileRect> tiles;
+    std::vector<TileRect> visibleBounds;
+    std::vector<TileRect> packedBounds;
+    std::vector<std::vector<MipLevel>> mips; // per tile, of its visible part; see BuildMipChains
+    std::vector<RleTile> compressed;         // per tile, of its visible part; see CompressAtlas
+    std::vector<unsigned char> decoded;
+    MappedFile mapping;
+};
+
+// Both atlases a toggle draws from, immutable once published.
+struct ToggleAtlases
+{
+    ImageAtlas body;
+    ImageAtlas knob;
+};
+
+// Builds an atlas over an in-memory .tglatlas image without copying; data must outlive it, or at
+// least the CompressAtlas call that copies the tiles out of it.
+// Throws std::runtime_error when the image is invalid or has a different tile layout.
+ImageAtlas LoadAtlasFromBakedImage(const void* data, std::size_t size, const AtlasLayout& layout);
+
+// Loads <directory>/<layout.name> (UTF-8), preferring the baked .tglatlas, which is mapped
+// rather than read into a buffer, and decoding the .png when no baked file exists or it is rejected (other
+// layout, damaged). Throws on failure.
+ImageAtlas LoadAtlasFromDirectory(const std::string& directory, const AtlasLayout& layout);
+
+// Fills atlas.mips with the mip chain of every tile's visible bounds, so tiles drawn smaller
+// than authored are scaled from a level close to their size (DPI scaling, small controls).
+void BuildMipChains(ImageAtlas& atlas);
+
+// Fills atlas.compressed with every tile's visible part run-length compressed, a heap copy of
+// the opaque and partial runs, then drops the pixels: the decoded buffer is freed, the mapping
+// closed and pixels reset to null. Caller-owned data (the embedded images) is left as it is.
+void CompressAtlas(ImageAtlas& atlas);
+
+// Loads the body and knob atlases concurrently through loadAtlas, builds their mip chains,
+// compresses them and joins them. Throws the first failure.
+std::unique_ptr<ToggleAtlases> LoadToggleAtlases(const std::function<ImageAtlas(const AtlasLayout&)>& loadAtlas);
+} // namespace ui
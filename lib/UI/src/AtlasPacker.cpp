@@ -0,0 +1,181 @@
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace ui
+{
+namespace
+{
+// Top edge of the packed area over [x, x + width).
+struct SkylineSegment
+{
+    int x;
+    int y;
+    int width;
+};
+
+// Packs sizes in the given order into a bin binWidth wide. Returns the bin height needed, or
+// INT_MAX when a rectangle is wider than the bin.
+int PackSkyline(const std::vector<TileRect>& sizes, const std::vector<std::size_t>& order, int binWidth, std::vector<TileRect>& placed)
+{
+    std::vector<SkylineSegment> skyline{SkylineSegment{0, 0, binWidth}};
+    int binHeight = 0;
+    for (const std::size_t index : order)
+    {
+        const int width = sizes[index].width;
+        const int height = sizes[index].height;
+        if (width > binWidth)
+        {
+            return INT_MAX;
+        }
+
+        // Bottom-left rule: the lowest top edge, then the leftmost position.
+        std::size_t bestSegment = 0;
+        int bestX = 0;
+        int bestY = 0;
+        int bestTop = INT_MAX;
+        for (std::size_t i = 0; i < skyline.size() && skyline[i].x + width <= binWidth; ++i)
+        {
+            int y = 0;
+            int covered = 0;
+            for (std::size_t j = i; covered < width; ++j)
+            {
+                y = std::max(y, skyline[j].y);
+                covered += skyline[j].width;
+            }
+            if (y + height < bestTop)
+            {
+                bestSegment = i;
+                bestX = skyline[i].x;
+                bestY = y;
+                bestTop = y + height;
+            }
+        }
+
+        placed[index] = TileRect{bestX, bestY, width, height};
+        binHeight = std::max(binHeight, bestTop);
+
+        // Raise the skyline under the new rectangle and trim the segments it now covers.
+        const int right = bestX + width;
+        skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(bestSegment), SkylineSegment{bestX, bestTop, width});
+        std::size_t next = bestSegment + 1;
+        while (next < skyline.size() && skyline[next].x < right)
+        {
+            const int overlap = right - skyline[next].x;
+            if (overlap >= skyline[next].width)
+            {
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(next));
+                continue;
+            }
+            skyline[next].x += overlap;
+            skyline[next].width -= overlap;
+            break;
+        }
+
+        for (std::size_t i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].y == skyline[i + 1].y)
+            {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+    return binHeight;
+}
+} // namespace
+
+std::vector<TileRect> PackRects(const std::vector<TileRect>& sizes, int& width, int& height)
+{
+    std::vector<TileRect> placed(sizes.size(), TileRect{0, 0, 0, 0});
+    width = 0;
+    height = 0;
+
+    // Tallest first, which suits the skyline; empty rectangles take no space.
+    std::vector<std::size_t> order;
+    long long area = 0;
+    int widest = 0;
+    for (std::size_t i = 0; i < sizes.size(); ++i)
+    {
+        if (sizes[i].width > 0 && sizes[i].height > 0)
+        {
+            order.push_back(i);
+            area += static_cast<long long>(sizes[i].width) * sizes[i].height;
+            widest = std::max(widest, sizes[i].width);
+        }
+    }
+    if (order.empty())
+    {
+        return placed;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return sizes[a].height != sizes[b].height ? sizes[a].height > sizes[b].height : sizes[a].width > sizes[b].width;
+    });
+
+    // Candidate widths: the widest rectangle, a square, and every row of the widest ones side by side.
+    std::vector<int> candidates{widest, std::max(widest, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area)))))};
+    std::vector<int> widths;
+    for (const std::size_t index : order)
+    {
+        widths.push_back(sizes[index].width);
+    }
+    std::sort(widths.begin(), widths.end(), [](int a, int b) { return a > b; });
+    int rowWidth = 0;
+    for (const int w : widths)
+    {
+        rowWidth += w;
+        candidates.push_back(rowWidth);
+    }
+
+    long long bestArea = LLONG_MAX;
+    std::vector<TileRect> attempt(sizes.size(), TileRect{0, 0, 0, 0});
+    for (const int candidate : candidates)
+    {
+        const int candidateHeight = PackSkyline(sizes, order, candidate, attempt);
+        const long long candidateArea = static_cast<long long>(candidate) * candidateHeight;
+        if (candidateHeight != INT_MAX && candidateArea < bestArea)
+        {
+            bestArea = candidateArea;
+            placed = attempt;
+            width = candidate;
+            height = candidateHeight;
+        }
+    }
+
+    // The widest candidates may leave the right edge unused.
+    int usedWidth = 0;
+    for (const TileRect& rect : placed)
+    {
+        usedWidth = std::max(usedWidth, rect.x + rect.width);
+    }
+    width = usedWidth;
+    return placed;
+}
+
+PackedAtlas PackVisibleTiles(const unsigned char* pixels, int atlasWidth, const std::vector<TileRect>& visibleBounds)
+{
+    PackedAtlas packed;
+    packed.packedBounds = PackRects(visibleBounds, packed.width, packed.height);
+    packed.pixels.assign(static_cast<std::size_t>(packed.width) * packed.height * 4, 0);
+    for (std::size_t i = 0; i < visibleBounds.size(); ++i)
+    {
+        const TileRect& from = visibleBounds[i];
+        const TileRect& to = packed.packedBounds[i];
+        for (int y = 0; y < from.height; ++y)
+        {
+            const unsigned char* source = pixels + (static_cast<std::size_t>(from.y + y) * atlasWidth + from.x) * 4;
+            unsigned char* destination = packed.pixels.data() + (static_cast<std::size_t>(to.y + y) * packed.width + to.x) * 4;
+            std::memcpy(destination, source, static_cast<std::size_t>(from.width) * 4);
+        }
+    }
+    return packed;
+}
+} // namespace ui
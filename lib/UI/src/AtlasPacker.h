@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Atlas.h"
+
+#include <vector>
+
+// Tight atlas repacking: every tile is trimmed to its visible bounds and the trimmed
+// rectangles are packed into a smaller image, dropping the transparent margins of the
+// authored grid. Used when baking and when loading a PNG atlas.
+namespace ui
+{
+struct PackedAtlas
+{
+    int width = 0;
+    int height = 0;
+    std::vector<TileRect> packedBounds; // where each input rectangle landed, index-aligned
+    std::vector<unsigned char> pixels;  // 32-bit pixels, rows width * 4 bytes apart
+};
+
+// Places rectangles of the given sizes (x and y are ignored) without overlap using a skyline
+// bottom-left packer, trying several bin widths and keeping the smallest area. Returns the
+// placed rectangles in input order and sets width and height to the bin size.
+std::vector<TileRect> PackRects(const std::vector<TileRect>& sizes, int& width, int& height);
+
+// Copies each visibleBounds rectangle of pixels (32-bit, rows atlasWidth * 4 bytes apart)
+// into a tightly packed image. packedBounds[i] maps visibleBounds[i] into it, same size.
+PackedAtlas PackVisibleTiles(const unsigned char* pixels, int atlasWidth, const std::vector<TileRect>& visibleBounds);
+} // namespace ui
@@ -0,0 +1,143 @@
+#include "Compositor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace ui
+{
+namespace
+{
+// Rectangle edges are summed in 64 bits, so extents near the int range cannot wrap; results
+// are clamped back into it.
+int ClampToInt(long long value)
+{
+    return static_cast<int>(std::max<long long>(std::numeric_limits<int>::min(), std::min<long long>(std::numeric_limits<int>::max(), value)));
+}
+
+// Source index whose pixel center is nearest to the center of destination index i.
+int SampleIndex(int i, int destinationCount, int sourceCount)
+{
+    return static_cast<int>((static_cast<long long>(2 * i + 1) * sourceCount) / (2LL * destinationCount));
+}
+
+template <typename Blend>
+void Composite(const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect, const TileRect& clip, Blend&& blend)
+{
+    if (destRect.width <= 0 || destRect.height <= 0 || sourceRect.width <= 0 || sourceRect.height <= 0)
+    {
+        return;
+    }
+
+    const TileRect area = IntersectRects(IntersectRects(destRect, clip), TileRect{0, 0, target.width, target.height});
+    if (area.width <= 0 || area.height <= 0)
+    {
+        return;
+    }
+
+    // Horizontal scaling gathers each source row into a contiguous span first, so the blend
+    // kernels only ever see 1:1 spans. Scratch space is per thread and reused across calls.
+    const bool scaleX = destRect.width != sourceRect.width;
+    thread_local std::vector<int> columns;
+    thread_local std::vector<unsigned char> gathered;
+    if (scaleX)
+    {
+        columns.resize(static_cast<std::size_t>(area.width));
+        gathered.resize(static_cast<std::size_t>(area.width) * 4);
+        for (int x = 0; x < area.width; ++x)
+        {
+            columns[x] = (sourceRect.x + SampleIndex(area.x - destRect.x + x, destRect.width, sourceRect.width)) * 4;
+        }
+    }
+
+    const int firstSourceColumn = sourceRect.x + (area.x - destRect.x);
+    for (int y = 0; y < area.height; ++y)
+    {
+        const int sourceY = sourceRect.y + SampleIndex(area.y - destRect.y + y, destRect.height, sourceRect.height);
+        const unsigned char* sourceRow = source.pixels + static_cast<std::ptrdiff_t>(sourceY) * source.stride;
+        unsigned char* targetRow = target.pixels + static_cast<std::ptrdiff_t>(area.y + y) * target.stride + static_cast<std::ptrdiff_t>(area.x) * 4;
+
+        if (scaleX)
+        {
+            for (int x = 0; x < area.width; ++x)
+            {
+                std::memcpy(&gathered[static_cast<std::size_t>(x) * 4], sourceRow + columns[x], 4);
+            }
+            blend(gathered.data(), targetRow, static_cast<std::size_t>(area.width));
+        }
+        else
+        {
+            blend(sourceRow + static_cast<std::ptrdiff_t>(firstSourceColumn) * 4, targetRow, static_cast<std::size_t>(area.width));
+        }
+    }
+}
+} // namespace
+
+TileRect IntersectRects(const TileRect& a, const TileRect& b)
+{
+    const int left = std::max(a.x, b.x);
+    const int top = std::max(a.y, b.y);
+    const long long right = std::min(static_cast<long long>(a.x) + a.width, static_cast<long long>(b.x) + b.width);
+    const long long bottom = std::min(static_cast<long long>(a.y) + a.height, static_cast<long long>(b.y) + b.height);
+    return TileRect{left, top, ClampToInt(std::max(0LL, right - left)), ClampToInt(std::max(0LL, bottom - top))};
+}
+
+TileRect UnionRects(const TileRect& a, const TileRect& b)
+{
+    if (a.width <= 0 || a.height <= 0)
+    {
+        return b;
+    }
+    if (b.width <= 0 || b.height <= 0)
+    {
+        return a;
+    }
+
+    const int left = std::min(a.x, b.x);
+    const int top = std::min(a.y, b.y);
+    const long long right = std::max(static_cast<long long>(a.x) + a.width, static_cast<long long>(b.x) + b.width);
+    const long long bottom = std::max(static_cast<long long>(a.y) + a.height, static_cast<long long>(b.y) + b.height);
+    return TileRect{left, top, ClampToInt(right - left), ClampToInt(bottom - top)};
+}
+
+void FillSurface(const SurfaceView& target, const TileRect& rect, std::uint32_t color)
+{
+    const TileRect area = IntersectRects(rect, TileRect{0, 0, target.width, target.height});
+    if (area.width <= 0 || area.height <= 0)
+    {
+        return;
+    }
+
+    const std::size_t rowBytes = static_cast<std::size_t>(area.width) * 4;
+    unsigned char* firstRow = target.pixels + static_cast<std::ptrdiff_t>(area.y) * target.stride + static_cast<std::ptrdiff_t>(area.x) * 4;
+    for (int x = 0; x < area.width; ++x)
+    {
+        std::memcpy(firstRow + static_cast<std::size_t>(x) * 4, &color, 4);
+    }
+    for (int y = 1; y < area.height; ++y)
+    {
+        std::memcpy(firstRow + static_cast<std::ptrdiff_t>(y) * target.stride, firstRow, rowBytes);
+    }
+}
+
+void CompositeSrcOver(const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect, const TileRect& clip)
+{
+    Composite(target, destRect, source, sourceRect, clip, [](const unsigned char* src, unsigned char* dst, std::size_t count) {
+        BlendSrcOver(src, dst, count);
+    });
+}
+
+void CompositeSrcOver(const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect)
+{
+    CompositeSrcOver(target, destRect, source, sourceRect, TileRect{0, 0, target.width, target.height});
+}
+
+void CompositeSrcOver(PixelKernel kernel, const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect, const TileRect& clip)
+{
+    Composite(target, destRect, source, sourceRect, clip, [kernel](const unsigned char* src, unsigned char* dst, std::size_t count) {
+        BlendSrcOver(kernel, src, dst, count);
+    });
+}
+} // namespace ui
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Atlas.h"
+#include "PixelKernels.h"
+
+#include <cstdint>
+
+// Portable software compositor for premultiplied BGRA images (the GDI 32-bit DIB layout).
+// Platform backends only present the finished buffer.
+namespace ui
+{
+// Read-only premultiplied BGRA pixels with rows stride bytes apart. Does not own them.
+struct ImageView
+{
+    const unsigned char* pixels;
+    int width;
+    int height;
+    int stride;
+};
+
+// Writable premultiplied BGRA pixels, the target of compositing. Does not own them.
+struct SurfaceView
+{
+    unsigned char* pixels;
+    int width;
+    int height;
+    int stride;
+};
+
+// Overlap of two rectangles; an empty result has zero width or height.
+TileRect IntersectRects(const TileRect& a, const TileRect& b);
+
+// Smallest rectangle containing both; an empty rectangle contributes nothing.
+TileRect UnionRects(const TileRect& a, const TileRect& b);
+
+// Fills rect, clipped to the surface, with one premultiplied color laid out as 0xAARRGGBB.
+void FillSurface(const SurfaceView& target, const TileRect& rect, std::uint32_t color);
+
+// Composites sourceRect of source over destRect of target with premultiplied source-over,
+// the operation AlphaBlend performs for AC_SRC_OVER with AC_SRC_ALPHA. Differing sizes are
+// scaled nearest-neighbour, sampling source pixel centers. sourceRect must lie inside
+// source. Only pixels inside clip and the surface are written; sampling does not depend on
+// the clip, so a clipped redraw matches the same area of a full one.
+void CompositeSrcOver(const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect, const TileRect& clip);
+
+// CompositeSrcOver clipped to the whole surface.
+void CompositeSrcOver(const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect);
+
+// Same composite blended through one kernel; the kernel must be supported.
+void CompositeSrcOver(PixelKernel kernel, const SurfaceView& target, const TileRect& destRect, const ImageView& source, const TileRect& sourceRect, const TileRect& clip);
+} // namespace ui
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AtlasLoader.h"
+
+#include <cstddef>
+#include <stdexcept>
+
+// Baked atlases compiled into the binary. The definitions are generated at build time by
+// `UIAtlasBaker --embed` and only linked when UI_TOGGLE_EMBED_ASSETS is enabled, which also
+// defines UI_TOGGLE_EMBEDDED_ATLASES for consumers.
+namespace ui
+{
+struct EmbeddedAtlas
+{
+    const char* name;
+    const unsigned char* data;
+    std::size_t size;
+};
+
+// Returns the embedded .tglatlas image for an atlas file stem, or nullptr.
+const EmbeddedAtlas* FindEmbeddedAtlas(const char* name);
+
+// Builds an atlas over its embedded image without file system access. The pixels are read in
+// place until CompressAtlas copies each tile into its run-length form; the embedded image
+// itself stays in the module and is never released.
+inline ImageAtlas LoadEmbeddedAtlas(const AtlasLayout& layout)
+{
+    const EmbeddedAtlas* embedded = FindEmbeddedAtlas(layout.name);
+    if (embedded == nullptr)
+    {
+        throw std::runtime_error("Atlas is not embedded");
+    }
+    return LoadAtlasFromBakedImage(embedded->data, embedded->size, layout);
+}
+} // namespace ui
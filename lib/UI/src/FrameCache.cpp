@@ -0,0 +1,123 @@
+#include "FrameCache.h"
+
+#include <cstring>
+
+namespace ui
+{
+std::size_t FrameKeyHash::operator()(const FrameKey& key) const
+{
+    // FNV-1a over the key fields.
+    const std::uint32_t fields[] = {
+        static_cast<std::uint32_t>(key.bodyStyle),
+        static_cast<std::uint32_t>(key.switchStyle),
+        static_cast<std::uint32_t>(key.knobOffset),
+        static_cast<std::uint32_t>(key.width),
+        static_cast<std::uint32_t>(key.height),
+        key.background};
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const std::uint32_t field : fields)
+    {
+        hash = (hash ^ field) * 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+std::shared_ptr<const ComposedFrame> GetComposedFrame(
+    FrameCache& cache,
+    const ToggleAtlases& atlases,
+    const ToggleAppearance& appearance,
+    std::uint32_t background,
+    int width,
+    int height,
+    int* composedPixels)
+{
+    if (composedPixels != nullptr)
+    {
+        *composedPixels = 0;
+    }
+
+    const FrameKey key{appearance.bodyStyle, appearance.switchStyle, appearance.knobOffset, width, height, background};
+    if (std::shared_ptr<const ComposedFrame> cached = cache.Find(key))
+    {
+        return cached;
+    }
+
+    const std::size_t bytes = static_cast<std::size_t>(width) * height * 4;
+    if (!cache.Accepts(bytes))
+    {
+        return nullptr;
+    }
+
+    auto frame = std::make_shared<ComposedFrame>();
+    frame->width = width;
+    frame->height = height;
+    frame->pixels.resize(bytes);
+    const SurfaceView target{frame->pixels.data(), width, height, width * 4};
+    RenderToggle(target, TileRect{0, 0, width, height}, background, &atlases, appearance);
+    if (composedPixels != nullptr)
+    {
+        *composedPixels = width * height;
+    }
+
+    cache.Insert(key, frame, frame->pixels.size());
+    return frame;
+}
+
+int PaintFrame(
+    FrameCache& cache,
+    const SurfaceView& target,
+    const TileRect& rect,
+    const ToggleAtlases& atlases,
+    const ToggleAppearance& appearance,
+    std::uint32_t background)
+{
+    const FrameKey key{appearance.bodyStyle, appearance.switchStyle, appearance.knobOffset, target.width, target.height, background};
+    if (std::shared_ptr<const ComposedFrame> cached = cache.Find(key))
+    {
+        CopyFrame(target, *cached, rect);
+        return 0;
+    }
+
+    const TileRect area = IntersectRects(rect, TileRect{0, 0, target.width, target.height});
+    if (area.width <= 0 || area.height <= 0)
+    {
+        return 0;
+    }
+    RenderToggle(target, area, background, &atlases, appearance);
+
+    // Caching costs a copy of the buffer, not a compose of the parts outside rect.
+    const std::size_t rowBytes = static_cast<std::size_t>(target.width) * 4;
+    const std::size_t bytes = rowBytes * target.height;
+    if (cache.Accepts(bytes))
+    {
+        auto frame = std::make_shared<ComposedFrame>();
+        frame->width = target.width;
+        frame->height = target.height;
+        frame->pixels.resize(bytes);
+        for (int y = 0; y < target.height; ++y)
+        {
+            std::memcpy(frame->pixels.data() + y * rowBytes, target.pixels + static_cast<std::size_t>(y) * target.stride, rowBytes);
+        }
+        cache.Insert(key, frame, bytes);
+    }
+    return area.width * area.height;
+}
+
+void CopyFrame(const SurfaceView& target, const ComposedFrame& frame, const TileRect& rect)
+{
+    const TileRect area = IntersectRects(IntersectRects(rect, TileRect{0, 0, frame.width, frame.height}), TileRect{0, 0, target.width, target.height});
+    if (area.width <= 0 || area.height <= 0)
+    {
+        return;
+    }
+
+    const std::size_t rowBytes = static_cast<std::size_t>(area.width) * 4;
+    for (int y = area.y; y < area.y + area.height; ++y)
+    {
+        const unsigned char* source = frame.pixels.data() + (static_cast<std::size_t>(y) * frame.width + area.x) * 4;
+        unsigned char* destination = target.pixels + static_cast<std::size_t>(y) * target.stride + static_cast<std::size_t>(area.x) * 4;
+        std::memcpy(destination, source, rowBytes);
+    }
+}
+} // namespace ui
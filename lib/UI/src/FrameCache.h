@@ -0,0 +1,77 @@
+#pragma once
+
+#include "LruCache.h"
+#include "ToggleRenderer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Fully composed toggle frames, shared by every control with the same look and size. During
+// a transition all such controls paint the same few knob offsets, so each frame is composed
+// once and later paints are a plain copy.
+namespace ui
+{
+struct FrameKey
+{
+    int bodyStyle;
+    int switchStyle;
+    int knobOffset;
+    int width;
+    int height;
+    std::uint32_t background;
+
+    bool operator==(const FrameKey& other) const
+    {
+        return bodyStyle == other.bodyStyle && switchStyle == other.switchStyle && knobOffset == other.knobOffset &&
+            width == other.width && height == other.height && background == other.background;
+    }
+};
+
+struct FrameKeyHash
+{
+    std::size_t operator()(const FrameKey& key) const;
+};
+
+// An opaque BGRA frame, top-down with rows width * 4 bytes apart.
+struct ComposedFrame
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+using FrameCache = LruCache<FrameKey, ComposedFrame, FrameKeyHash>;
+
+constexpr std::size_t kDefaultFrameCacheBudget = 8 * 1024 * 1024;
+
+// The width x height frame for appearance over background, from the cache or rendered with
+// RenderToggle and cached. A frame the cache cannot hold (disabled, or over the budget) is
+// not composed at all: nullptr is returned and the caller renders just the part it needs.
+// composedPixels, if given, receives the pixels rendered here, zero on a hit. Frames depend
+// on the atlases, so one cache serves one snapshot.
+std::shared_ptr<const ComposedFrame> GetComposedFrame(
+    FrameCache& cache,
+    const ToggleAtlases& atlases,
+    const ToggleAppearance& appearance,
+    std::uint32_t background,
+    int width,
+    int height,
+    int* composedPixels = nullptr);
+
+// Paints rect of the frame for appearance over background into target, a persistent buffer
+// of the whole frame whose pixels outside rect are already up to date. A cached frame is
+// copied; on a miss only rect is rendered, and the buffer, now the whole frame, is cached
+// when the cache can hold it. Returns the pixels rendered, zero on a hit.
+int PaintFrame(
+    FrameCache& cache,
+    const SurfaceView& target,
+    const TileRect& rect,
+    const ToggleAtlases& atlases,
+    const ToggleAppearance& appearance,
+    std::uint32_t background);
+
+// Copies rect of frame into the same place of target, clipped to both. Opaque, no blending.
+void CopyFrame(const SurfaceView& target, const ComposedFrame& frame, const TileRect& rect);
+} // namespace ui
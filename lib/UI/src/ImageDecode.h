@@ -0,0 +1,15 @@
+#pragma once
+
+// PNG (and other stb_image formats) decoding into caller-owned memory. Implemented in
+// StbImage.cpp next to the stb_image allocator hooks that make it copy-free.
+namespace ui
+{
+// Reads the pixel dimensions from the image header without decoding. Throws on failure.
+void ReadImageSize(const char* path, int& width, int& height);
+
+// Decodes path as 8-bit straight RGBA into dst, which holds width * height * 4 bytes with
+// tightly packed rows (the size ReadImageSize reported). stb_image's output allocation is
+// redirected to dst, so no intermediate image buffer exists. Returns false if the decoder
+// took a route that still needed one (dst is filled either way). Throws on failure.
+bool DecodeRgbaInto(const char* path, unsigned char* dst, int width, int height);
+} // namespace ui
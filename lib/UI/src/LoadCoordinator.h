@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+// Coordinates one shared, retryable load of an immutable value that may run inline on a
+// caller's thread or on a background worker. Thread creation is left to the platform layer.
+//
+// The loaded value is published once through an atomic pointer with release semantics, so
+// readers only pay for one acquire load and never take the mutex; the mutex is confined to
+// the cold claim/finish/wait paths.
+namespace ui
+{
+template <typename T>
+class LoadCoordinator
+{
+public:
+    LoadCoordinator() = default;
+    LoadCoordinator(const LoadCoordinator&) = delete;
+    LoadCoordinator& operator=(const LoadCoordinator&) = delete;
+
+    ~LoadCoordinator()
+    {
+        Reset();
+    }
+
+    // The published value, or nullptr before a load succeeds. Lock-free.
+    const T* Get() const
+    {
+        return value_.load(std::memory_order_acquire);
+    }
+
+    bool IsLoading() const
+    {
+        return loading_.load(std::memory_order_acquire);
+    }
+
+    // Claims the load for the calling thread. False while another load runs or once loaded.
+    bool TryBegin()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (loading_.load(std::memory_order_relaxed) || value_.load(std::memory_order_relaxed) != nullptr)
+        {
+            return false;
+        }
+
+        loading_.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Ends a claimed load and wakes waiters. A null value marks failure, after which a later
+    // caller may claim the load again.
+    void Finish(std::unique_ptr<const T> value)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            value_.store(value.release(), std::memory_order_release);
+            loading_.store(false, std::memory_order_release);
+        }
+        finished_.notify_all();
+    }
+
+    // Blocks while a load is in flight, then returns the published value (nullptr on failure).
+    const T* WaitWhileLoading()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [this]() { return !loading_.load(std::memory_order_relaxed); });
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    // Destroys the published value. Only valid when no reader or loader can be active,
+    // e.g. on library unload.
+    void Reset()
+    {
+        delete value_.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+private:
+    std::atomic<const T*> value_{nullptr};
+    std::atomic<bool> loading_{false};
+    std::mutex mutex_;
+    std::condition_variable finished_;
+};
+} // namespace ui
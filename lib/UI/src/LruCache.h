@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+// Thread-safe least-recently-used cache bounded by the bytes its values occupy. Values are
+// immutable and shared, so an entry evicted while a caller still uses it stays alive until
+// that caller lets go. Lookups and inserts take one mutex; callers do the expensive work of
+// producing a value outside it.
+namespace ui
+{
+struct CacheStats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::size_t entries = 0;
+    std::size_t bytesUsed = 0;
+    std::size_t byteBudget = 0;
+};
+
+template <typename Key, typename Value, typename Hash>
+class LruCache
+{
+public:
+    explicit LruCache(std::size_t byteBudget) : byteBudget_(byteBudget)
+    {
+    }
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // The cached value for key, marked most recently used, or nullptr. Counts a hit or a miss.
+    std::shared_ptr<const Value> Find(const Key& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto found = index_.find(key);
+        if (found == index_.end())
+        {
+            ++misses_;
+            return nullptr;
+        }
+
+        ++hits_;
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return found->second->value;
+    }
+
+    // Caches value under key as most recently used, evicting the least recently used entries
+    // until the budget holds. A value larger than the whole budget is not cached. When key is
+    // already present (another thread produced it first) the existing entry is kept.
+    void Insert(const Key& key, std::shared_ptr<const Value> value, std::size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bytes > byteBudget_ || index_.find(key) != index_.end())
+        {
+            return;
+        }
+
+        entries_.push_front(Entry{key, std::move(value), bytes});
+        index_.emplace(key, entries_.begin());
+        bytesUsed_ += bytes;
+        EvictToBudget();
+    }
+
+    // Whether a value of bytes fits the budget at all, so producing it for Insert is worthwhile.
+    bool Accepts(std::size_t bytes) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes <= byteBudget_;
+    }
+
+    // Changes the budget, evicting at once if the cache is over it. Zero disables caching.
+    void SetByteBudget(std::size_t byteBudget)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        byteBudget_ = byteBudget;
+        EvictToBudget();
+    }
+
+    // Drops every entry; the counters are kept.
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_.clear();
+        entries_.clear();
+        bytesUsed_ = 0;
+    }
+
+    CacheStats Stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CacheStats stats;
+        stats.hits = hits_;
+        stats.misses = misses_;
+        stats.entries = entries_.size();
+        stats.bytesUsed = bytesUsed_;
+        stats.byteBudget = byteBudget_;
+        return stats;
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<const Value> value;
+        std::size_t bytes;
+    };
+
+    void EvictToBudget()
+    {
+        while (bytesUsed_ > byteBudget_)
+        {
+            const Entry& oldest = entries_.back();
+            bytesUsed_ -= oldest.bytes;
+            index_.erase(oldest.key);
+            entries_.pop_back();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_; // most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+    std::size_t bytesUsed_ = 0;
+    std::size_t byteBudget_;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+} // namespace ui
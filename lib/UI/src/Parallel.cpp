@@ -0,0 +1,86 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace ui
+{
+namespace
+{
+// Set while a thread runs the tasks of a fanned-out ParallelFor.
+thread_local bool t_inParallelFor = false;
+} // namespace
+
+unsigned ParallelismDegree()
+{
+    static const unsigned degree = std::max(1u, std::thread::hardware_concurrency());
+    return degree;
+}
+
+void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    const std::size_t workers = t_inParallelFor ? 1 : std::min<std::size_t>(count, ParallelismDegree());
+    if (workers <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        t_inParallelFor = true;
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+        {
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+        t_inParallelFor = false;
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    try
+    {
+        for (std::size_t i = 1; i < workers; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+    }
+    catch (const std::system_error&)
+    {
+        // Out of threads: the ones already started and this thread finish the work.
+    }
+
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+} // namespace ui
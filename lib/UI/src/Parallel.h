@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Fork-join helpers for load-time work. Threads are created per call and joined before it
+// returns, so nothing outlives the caller (important inside a DLL).
+namespace ui
+{
+// Hardware threads available to ParallelFor, at least 1.
+unsigned ParallelismDegree();
+
+// Runs task(i) for every i in [0, count) on up to ParallelismDegree() threads, the calling
+// thread included, and returns once all have finished. The first exception thrown by a
+// task is rethrown after the join. Called from inside a task it runs serially on that task's
+// thread: only the outermost level fans out, so nesting never multiplies the thread count.
+void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+} // namespace ui
@@ -0,0 +1,447 @@
+#include "PixelKernels.h"
+
+#include "Parallel.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UI_PIXEL_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define UI_PIXEL_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UI_TARGET_SSE2 __attribute__((target("sse2")))
+#define UI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define UI_TARGET_SSE2
+#define UI_TARGET_AVX2
+#endif
+
+namespace ui
+{
+namespace
+{
+using PremultiplyFn = void (*)(const unsigned char*, unsigned char*, std::size_t);
+using BlendFn = void (*)(const unsigned char*, unsigned char*, std::size_t);
+
+// Below this many pixels per band, thread start-up costs more than the conversion.
+constexpr std::size_t kMinPixelsPerBand = 64 * 1024;
+
+// round(value * alpha / 255) without a division; exact for all 8-bit inputs.
+inline unsigned char MulDiv255(unsigned value, unsigned alpha)
+{
+    const unsigned t = value * alpha + 128;
+    return static_cast<unsigned char>((t + (t >> 8)) >> 8);
+}
+
+void PremultiplyScalar(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    for (std::size_t i = 0; i < pixelCount; ++i)
+    {
+        const unsigned char r = src[i * 4 + 0];
+        const unsigned char g = src[i * 4 + 1];
+        const unsigned char b = src[i * 4 + 2];
+        const unsigned char a = src[i * 4 + 3];
+        dst[i * 4 + 0] = MulDiv255(b, a);
+        dst[i * 4 + 1] = MulDiv255(g, a);
+        dst[i * 4 + 2] = MulDiv255(r, a);
+        dst[i * 4 + 3] = a;
+    }
+}
+
+void BlendSrcOverScalar(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    for (std::size_t i = 0; i < pixelCount; ++i)
+    {
+        const unsigned char* s = src + i * 4;
+        unsigned char* d = dst + i * 4;
+        if (s[3] == 255)
+        {
+            d[0] = s[0];
+            d[1] = s[1];
+            d[2] = s[2];
+            d[3] = 255;
+            continue;
+        }
+        if ((s[0] | s[1] | s[2] | s[3]) == 0)
+        {
+            continue;
+        }
+
+        const unsigned inverse = 255u - s[3];
+        for (int c = 0; c < 4; ++c)
+        {
+            const unsigned sum = s[c] + MulDiv255(d[c], inverse);
+            d[c] = static_cast<unsigned char>(sum > 255 ? 255 : sum);
+        }
+    }
+}
+
+#if defined(UI_PIXEL_KERNELS_X86)
+// Premultiplies and swizzles two pixels widened to 16-bit lanes (r, g, b, a, r, g, b, a).
+// The alpha lane is multiplied by 255 so it survives the same rounding divide unchanged.
+UI_TARGET_SSE2 inline __m128i PremultiplySwizzlePairSse2(__m128i pixels)
+{
+    const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaLane = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i bias = _mm_set1_epi16(128);
+
+    __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaLane);
+
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), bias);
+    t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+
+    t = _mm_shufflelo_epi16(t, _MM_SHUFFLE(3, 0, 1, 2));
+    return _mm_shufflehi_epi16(t, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+UI_TARGET_SSE2 void PremultiplySse2(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        const __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i lo = PremultiplySwizzlePairSse2(_mm_unpacklo_epi8(rgba, zero));
+        const __m128i hi = PremultiplySwizzlePairSse2(_mm_unpackhi_epi8(rgba, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+    }
+    PremultiplyScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+// AVX2 variant of PremultiplySwizzlePairSse2; each 128-bit lane holds two pixels.
+UI_TARGET_AVX2 inline __m256i PremultiplySwizzlePairAvx2(__m256i pixels)
+{
+    const __m256i colorMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1);
+    const __m256i alphaLane = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+    const __m256i bias = _mm256_set1_epi16(128);
+
+    __m256i alpha = _mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm256_or_si256(_mm256_and_si256(alpha, colorMask), alphaLane);
+
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(pixels, alpha), bias);
+    t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+
+    t = _mm256_shufflelo_epi16(t, _MM_SHUFFLE(3, 0, 1, 2));
+    return _mm256_shufflehi_epi16(t, _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+UI_TARGET_AVX2 void PremultiplyAvx2(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        const __m256i rgba = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        // Unpack and pack both work within 128-bit lanes, so pixel order is preserved.
+        const __m256i lo = PremultiplySwizzlePairAvx2(_mm256_unpacklo_epi8(rgba, zero));
+        const __m256i hi = PremultiplySwizzlePairAvx2(_mm256_unpackhi_epi8(rgba, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+    }
+    // The tail runs legacy-encoded SSE2; clear the upper halves first or every SSE2
+    // instruction there pays the AVX-to-SSE transition penalty.
+    _mm256_zeroupper();
+    PremultiplySse2(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+// dst * (255 - srcAlpha) / 255 for two pixels widened to 16-bit lanes.
+UI_TARGET_SSE2 inline __m128i ScaleByInverseAlphaSse2(__m128i src, __m128i dst)
+{
+    const __m128i bias = _mm_set1_epi16(128);
+
+    __m128i alpha = _mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(dst, inverse), bias);
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+UI_TARGET_SSE2 void BlendSrcOverSse2(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    std::size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF)
+        {
+            continue;
+        }
+        __m128i* out = reinterpret_cast<__m128i*>(dst + i * 4);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xFFFF)
+        {
+            _mm_storeu_si128(out, s);
+            continue;
+        }
+
+        const __m128i d = _mm_loadu_si128(out);
+        const __m128i lo = ScaleByInverseAlphaSse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+        const __m128i hi = ScaleByInverseAlphaSse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+        _mm_storeu_si128(out, _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+    }
+    BlendSrcOverScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+// AVX2 variant of ScaleByInverseAlphaSse2; each 128-bit lane holds two pixels.
+UI_TARGET_AVX2 inline __m256i ScaleByInverseAlphaAvx2(__m256i src, __m256i dst)
+{
+    const __m256i bias = _mm256_set1_epi16(128);
+
+    __m256i alpha = _mm256_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+    alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(dst, inverse), bias);
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+UI_TARGET_AVX2 void BlendSrcOverAvx2(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    std::size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(s, zero)) == -1)
+        {
+            continue;
+        }
+        __m256i* out = reinterpret_cast<__m256i*>(dst + i * 4);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alphaMask), alphaMask)) == -1)
+        {
+            _mm256_storeu_si256(out, s);
+            continue;
+        }
+
+        const __m256i d = _mm256_loadu_si256(out);
+        const __m256i lo = ScaleByInverseAlphaAvx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+        const __m256i hi = ScaleByInverseAlphaAvx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+        _mm256_storeu_si256(out, _mm256_adds_epu8(s, _mm256_packus_epi16(lo, hi)));
+    }
+    // The tail runs legacy-encoded SSE2; clear the upper halves first or every SSE2
+    // instruction there pays the AVX-to-SSE transition penalty.
+    _mm256_zeroupper();
+    BlendSrcOverSse2(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+bool CpuSupports(PixelKernel kernel)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    if (kernel == PixelKernel::Sse2)
+    {
+        return sse2;
+    }
+
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return kernel == PixelKernel::Avx2 && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    if (kernel == PixelKernel::Sse2)
+    {
+        return __builtin_cpu_supports("sse2") != 0;
+    }
+    return kernel == PixelKernel::Avx2 && __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+#if defined(UI_PIXEL_KERNELS_NEON)
+inline uint8x16_t MulDiv255Neon(uint8x16_t value, uint8x16_t alpha)
+{
+    uint16x8_t lo = vmull_u8(vget_low_u8(value), vget_low_u8(alpha));
+    uint16x8_t hi = vmull_u8(vget_high_u8(value), vget_high_u8(alpha));
+    // (t + ((t + 128) >> 8) + 128) >> 8, identical to MulDiv255.
+    lo = vrsraq_n_u16(lo, lo, 8);
+    hi = vrsraq_n_u16(hi, hi, 8);
+    return vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+}
+
+void PremultiplyNeon(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        const uint8x16x4_t rgba = vld4q_u8(src + i * 4);
+        uint8x16x4_t bgra;
+        bgra.val[0] = MulDiv255Neon(rgba.val[2], rgba.val[3]);
+        bgra.val[1] = MulDiv255Neon(rgba.val[1], rgba.val[3]);
+        bgra.val[2] = MulDiv255Neon(rgba.val[0], rgba.val[3]);
+        bgra.val[3] = rgba.val[3];
+        vst4q_u8(dst + i * 4, bgra);
+    }
+    PremultiplyScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+
+void BlendSrcOverNeon(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        const uint8x16x4_t s = vld4q_u8(src + i * 4);
+        uint8x16x4_t d = vld4q_u8(dst + i * 4);
+        const uint8x16_t inverse = vmvnq_u8(s.val[3]);
+        for (int c = 0; c < 4; ++c)
+        {
+            d.val[c] = vqaddq_u8(s.val[c], MulDiv255Neon(d.val[c], inverse));
+        }
+        vst4q_u8(dst + i * 4, d);
+    }
+    BlendSrcOverScalar(src + i * 4, dst + i * 4, pixelCount - i);
+}
+#endif
+
+PremultiplyFn ResolvePremultiply(PixelKernel kernel)
+{
+    switch (kernel)
+    {
+#if defined(UI_PIXEL_KERNELS_X86)
+        case PixelKernel::Sse2:
+            return PremultiplySse2;
+        case PixelKernel::Avx2:
+            return PremultiplyAvx2;
+#endif
+#if defined(UI_PIXEL_KERNELS_NEON)
+        case PixelKernel::Neon:
+            return PremultiplyNeon;
+#endif
+        default:
+            return PremultiplyScalar;
+    }
+}
+
+BlendFn ResolveBlendSrcOver(PixelKernel kernel)
+{
+    switch (kernel)
+    {
+#if defined(UI_PIXEL_KERNELS_X86)
+        case PixelKernel::Sse2:
+            return BlendSrcOverSse2;
+        case PixelKernel::Avx2:
+            return BlendSrcOverAvx2;
+#endif
+#if defined(UI_PIXEL_KERNELS_NEON)
+        case PixelKernel::Neon:
+            return BlendSrcOverNeon;
+#endif
+        default:
+            return BlendSrcOverScalar;
+    }
+}
+
+PixelKernel DetectPixelKernel()
+{
+    const PixelKernel preference[] = {PixelKernel::Avx2, PixelKernel::Neon, PixelKernel::Sse2};
+    for (PixelKernel kernel : preference)
+    {
+        if (IsPixelKernelSupported(kernel))
+        {
+            return kernel;
+        }
+    }
+    return PixelKernel::Scalar;
+}
+} // namespace
+
+bool IsPixelKernelSupported(PixelKernel kernel)
+{
+    switch (kernel)
+    {
+        case PixelKernel::Scalar:
+            return true;
+#if defined(UI_PIXEL_KERNELS_X86)
+        case PixelKernel::Sse2:
+        case PixelKernel::Avx2:
+            return CpuSupports(kernel);
+#endif
+#if defined(UI_PIXEL_KERNELS_NEON)
+        case PixelKernel::Neon:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+PixelKernel ActivePixelKernel()
+{
+    static const PixelKernel kernel = DetectPixelKernel();
+    return kernel;
+}
+
+const char* PixelKernelName(PixelKernel kernel)
+{
+    switch (kernel)
+    {
+        case PixelKernel::Sse2:
+            return "sse2";
+        case PixelKernel::Avx2:
+            return "avx2";
+        case PixelKernel::Neon:
+            return "neon";
+        default:
+            return "scalar";
+    }
+}
+
+void PremultiplyRgbaToBgra(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    static const PremultiplyFn premultiply = ResolvePremultiply(ActivePixelKernel());
+    premultiply(src, dst, pixelCount);
+}
+
+void PremultiplyRgbaToBgraRows(const unsigned char* src, unsigned char* dst, int width, int height)
+{
+    const std::size_t rowPixels = static_cast<std::size_t>(width);
+    const std::size_t totalPixels = rowPixels * static_cast<std::size_t>(height);
+    const std::size_t bandCount = std::max<std::size_t>(1, std::min<std::size_t>(ParallelismDegree(), totalPixels / kMinPixelsPerBand));
+    const std::size_t rowsPerBand = (static_cast<std::size_t>(height) + bandCount - 1) / bandCount;
+
+    ParallelFor(bandCount, [&](std::size_t band) {
+        const std::size_t firstRow = band * rowsPerBand;
+        const std::size_t lastRow = std::min<std::size_t>(firstRow + rowsPerBand, static_cast<std::size_t>(height));
+        if (firstRow < lastRow)
+        {
+            const std::size_t offset = firstRow * rowPixels * 4;
+            PremultiplyRgbaToBgra(src + offset, dst + offset, (lastRow - firstRow) * rowPixels);
+        }
+    });
+}
+
+void PremultiplyRgbaToBgra(PixelKernel kernel, const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    ResolvePremultiply(kernel)(src, dst, pixelCount);
+}
+
+void BlendSrcOver(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    static const BlendFn blend = ResolveBlendSrcOver(ActivePixelKernel());
+    blend(src, dst, pixelCount);
+}
+
+void BlendSrcOver(PixelKernel kernel, const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    ResolveBlendSrcOver(kernel)(src, dst, pixelCount);
+}
+} // namespace ui
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+// Pixel conversion and blending kernels with runtime-selected SIMD implementations.
+namespace ui
+{
+enum class PixelKernel
+{
+    Scalar,
+    Sse2,
+    Avx2,
+    Neon
+};
+
+// True when the running CPU (and this build) can execute the kernel.
+bool IsPixelKernelSupported(PixelKernel kernel);
+
+// Fastest supported kernel, resolved once on first use.
+PixelKernel ActivePixelKernel();
+
+const char* PixelKernelName(PixelKernel kernel);
+
+// Converts straight-alpha RGBA to premultiplied BGRA (the GDI 32-bit DIB order) in one pass.
+// Colors are scaled by alpha with exact rounding, round(c * a / 255). Every kernel produces
+// bit-identical output. src and dst may be the same buffer.
+void PremultiplyRgbaToBgra(const unsigned char* src, unsigned char* dst, std::size_t pixelCount);
+
+// PremultiplyRgbaToBgra over a width x height image with tightly packed rows, split into
+// row bands processed in parallel when the image is large enough to benefit.
+void PremultiplyRgbaToBgraRows(const unsigned char* src, unsigned char* dst, int width, int height);
+
+// Same conversion forced through one kernel; the kernel must be supported.
+void PremultiplyRgbaToBgra(PixelKernel kernel, const unsigned char* src, unsigned char* dst, std::size_t pixelCount);
+
+// Premultiplied source-over of a span of BGRA pixels: every channel, alpha included, becomes
+// min(255, src + round(dst * (255 - srcAlpha) / 255)). Fully transparent and fully opaque
+// source pixels skip the arithmetic with identical results. Every kernel produces
+// bit-identical output.
+void BlendSrcOver(const unsigned char* src, unsigned char* dst, std::size_t pixelCount);
+
+// Same blend forced through one kernel; the kernel must be supported.
+void BlendSrcOver(PixelKernel kernel, const unsigned char* src, unsigned char* dst, std::size_t pixelCount);
+} // namespace ui
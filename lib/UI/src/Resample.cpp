@@ -0,0 +1,185 @@
+#include "Resample.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ui
+{
+namespace
+{
+constexpr int kWeightBits = 14;
+constexpr int kWeightOne = 1 << kWeightBits;
+
+// One source sample feeding a destination pixel; weights of a pixel sum to kWeightOne.
+struct Tap
+{
+    int index;
+    int weight;
+};
+
+using AxisFilter = std::vector<std::vector<Tap>>;
+
+// Taps for every destination pixel along one axis, source indexes relative to the region.
+AxisFilter BuildAxisFilter(int sourceLength, int destinationLength)
+{
+    const std::int64_t s = sourceLength;
+    const std::int64_t d = destinationLength;
+    AxisFilter filter(static_cast<std::size_t>(destinationLength));
+    for (int i = 0; i < destinationLength; ++i)
+    {
+        std::vector<Tap>& taps = filter[static_cast<std::size_t>(i)];
+        if (s == d)
+        {
+            taps.push_back(Tap{i, kWeightOne});
+        }
+        else if (s > d)
+        {
+            // Destination pixel i covers source span [i * s, (i + 1) * s) in units of 1/d.
+            const std::int64_t start = i * s;
+            const std::int64_t end = start + s;
+            for (std::int64_t j = start / d; j * d < end; ++j)
+            {
+                const std::int64_t overlap = std::min(end, (j + 1) * d) - std::max(start, j * d);
+                taps.push_back(Tap{static_cast<int>(j), static_cast<int>((overlap * kWeightOne + s / 2) / s)});
+            }
+        }
+        else
+        {
+            // Center of pixel i in source pixels is ((2i + 1) * s - d) / 2d, clamped to the edges.
+            const std::int64_t position = std::max<std::int64_t>(0, (2 * i + 1) * s - d);
+            const std::int64_t j = position / (2 * d);
+            const int upper = j + 1 < s ? static_cast<int>(((position % (2 * d)) * kWeightOne + d) / (2 * d)) : 0;
+            taps.push_back(Tap{static_cast<int>(j), kWeightOne - upper});
+            if (upper > 0)
+            {
+                taps.push_back(Tap{static_cast<int>(j + 1), upper});
+            }
+        }
+
+        // Rounding can leave the sum a little off; settle the difference on the largest tap.
+        int sum = 0;
+        for (const Tap& tap : taps)
+        {
+            sum += tap.weight;
+        }
+        std::max_element(taps.begin(), taps.end(), [](const Tap& a, const Tap& b) { return a.weight < b.weight; })->weight += kWeightOne - sum;
+    }
+    return filter;
+}
+
+// Averages 2x2 blocks of sourceRect into target, which must be half its size rounded up. An
+// odd last row or column is averaged with itself (edge clamp).
+void HalveImage(const ImageView& source, const TileRect& sourceRect, const SurfaceView& target)
+{
+    for (int y = 0; y < target.height; ++y)
+    {
+        const int y0 = sourceRect.y + 2 * y;
+        const int y1 = std::min(y0 + 1, sourceRect.y + sourceRect.height - 1);
+        const unsigned char* row0 = source.pixels + static_cast<std::size_t>(y0) * source.stride;
+        const unsigned char* row1 = source.pixels + static_cast<std::size_t>(y1) * source.stride;
+        unsigned char* out = target.pixels + static_cast<std::size_t>(y) * target.stride;
+        for (int x = 0; x < target.width; ++x)
+        {
+            const std::size_t x0 = static_cast<std::size_t>(sourceRect.x + 2 * x) * 4;
+            const std::size_t x1 = static_cast<std::size_t>(std::min(sourceRect.x + 2 * x + 1, sourceRect.x + sourceRect.width - 1)) * 4;
+            for (int c = 0; c < 4; ++c)
+            {
+                const unsigned sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                out[x * 4 + c] = static_cast<unsigned char>((sum + 2) >> 2);
+            }
+        }
+    }
+}
+} // namespace
+
+void ResampleImage(const ImageView& source, const TileRect& sourceRect, const SurfaceView& target)
+{
+    if (sourceRect.width <= 0 || sourceRect.height <= 0 || target.width <= 0 || target.height <= 0)
+    {
+        return;
+    }
+
+    const AxisFilter columns = BuildAxisFilter(sourceRect.width, target.width);
+    const AxisFilter rows = BuildAxisFilter(sourceRect.height, target.height);
+
+    // Horizontal pass over every source row, kept with 8 extra bits of precision.
+    const std::size_t intermediateStride = static_cast<std::size_t>(target.width) * 4;
+    std::vector<std::uint16_t> intermediate(intermediateStride * sourceRect.height);
+    for (int y = 0; y < sourceRect.height; ++y)
+    {
+        const unsigned char* sourceRow = source.pixels + static_cast<std::size_t>(sourceRect.y + y) * source.stride + static_cast<std::size_t>(sourceRect.x) * 4;
+        std::uint16_t* out = intermediate.data() + intermediateStride * y;
+        for (int x = 0; x < target.width; ++x)
+        {
+            std::uint32_t sums[4] = {};
+            for (const Tap& tap : columns[static_cast<std::size_t>(x)])
+            {
+                const unsigned char* pixel = sourceRow + static_cast<std::size_t>(tap.index) * 4;
+                for (int c = 0; c < 4; ++c)
+                {
+                    sums[c] += static_cast<std::uint32_t>(pixel[c]) * static_cast<std::uint32_t>(tap.weight);
+                }
+            }
+            for (int c = 0; c < 4; ++c)
+            {
+                out[x * 4 + c] = static_cast<std::uint16_t>((sums[c] + (1u << (kWeightBits - 9))) >> (kWeightBits - 8));
+            }
+        }
+    }
+
+    // Vertical pass back to 8 bits with rounding.
+    constexpr int kShift = kWeightBits + 8;
+    for (int y = 0; y < target.height; ++y)
+    {
+        const std::vector<Tap>& taps = rows[static_cast<std::size_t>(y)];
+        unsigned char* out = target.pixels + static_cast<std::size_t>(y) * target.stride;
+        for (std::size_t i = 0; i < intermediateStride; ++i)
+        {
+            std::uint32_t sum = 0;
+            for (const Tap& tap : taps)
+            {
+                sum += static_cast<std::uint32_t>(intermediate[intermediateStride * tap.index + i]) * static_cast<std::uint32_t>(tap.weight);
+            }
+            out[i] = static_cast<unsigned char>((sum + (1u << (kShift - 1))) >> kShift);
+        }
+    }
+}
+
+std::vector<MipLevel> BuildMipChain(const ImageView& source, const TileRect& sourceRect)
+{
+    std::vector<MipLevel> chain;
+    ImageView previous = source;
+    TileRect previousRect = sourceRect;
+    while (previousRect.width > 1 && previousRect.height > 1)
+    {
+        MipLevel level;
+        level.width = (previousRect.width + 1) / 2;
+        level.height = (previousRect.height + 1) / 2;
+        level.pixels.resize(static_cast<std::size_t>(level.width) * level.height * 4);
+        HalveImage(previous, previousRect, SurfaceView{level.pixels.data(), level.width, level.height, level.width * 4});
+        chain.push_back(std::move(level));
+
+        const MipLevel& added = chain.back();
+        previous = ImageView{added.pixels.data(), added.width, added.height, added.width * 4};
+        previousRect = TileRect{0, 0, added.width, added.height};
+    }
+    return chain;
+}
+
+const MipLevel* SelectMipLevel(const std::vector<MipLevel>& chain, int width, int height)
+{
+    const MipLevel* selected = nullptr;
+    for (const MipLevel& level : chain)
+    {
+        if (level.width < width || level.height < height)
+        {
+            break;
+        }
+        selected = &level;
+    }
+    return selected;
+}
+} // namespace ui
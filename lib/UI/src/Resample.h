@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Compositor.h"
+
+#include <vector>
+
+// High-quality tile scaling for premultiplied BGRA images, done once per destination size
+// rather than per frame (see TileCache.h).
+namespace ui
+{
+// Scales sourceRect of source to cover all of target. Each axis is filtered on its own:
+// area averaging (box) where it shrinks, bilinear over pixel centers where it grows, a plain
+// copy where the size is unchanged. Premultiplied in and out; fixed point throughout, so
+// results are identical on every platform. sourceRect must lie inside source.
+void ResampleImage(const ImageView& source, const TileRect& sourceRect, const SurfaceView& target);
+
+// One level of a mip chain: premultiplied BGRA, rows width * 4 bytes apart.
+struct MipLevel
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+// Mip chain of sourceRect, level 0 (sourceRect itself) excluded: each level averages 2x2
+// blocks of the one before (halving, rounded up, with an edge clamp) down to a level with a
+// one-pixel side.
+std::vector<MipLevel> BuildMipChain(const ImageView& source, const TileRect& sourceRect);
+
+// The smallest level of chain at least width x height, or nullptr when only level 0 is. Scaling
+// from it shrinks by less than half, so the box filter reads at most about 4x the pixels it writes.
+const MipLevel* SelectMipLevel(const std::vector<MipLevel>& chain, int width, int height);
+} // namespace ui
@@ -0,0 +1,113 @@
+#include "RleTile.h"
+
+#include "PixelKernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ui
+{
+RleTile CompressTile(const ImageView& image, const TileRect& rect)
+{
+    RleTile tile;
+    tile.spans = BuildSpanTable(image, rect);
+    tile.rowPixels.reserve(static_cast<std::size_t>(rect.height) + 1);
+
+    std::size_t stored = 0;
+    for (const AlphaSpan& span : tile.spans.spans)
+    {
+        stored += span.kind == SpanKind::Transparent ? 0 : static_cast<std::size_t>(span.length);
+    }
+    tile.pixels.resize(stored * 4);
+
+    std::uint32_t cursor = 0;
+    for (int y = 0; y < rect.height; ++y)
+    {
+        tile.rowPixels.push_back(cursor);
+        const unsigned char* row = image.pixels + static_cast<std::ptrdiff_t>(rect.y + y) * image.stride + static_cast<std::ptrdiff_t>(rect.x) * 4;
+        const AlphaSpan* span = tile.spans.spans.data() + tile.spans.rowStarts[static_cast<std::size_t>(y)];
+        const AlphaSpan* end = tile.spans.spans.data() + tile.spans.rowStarts[static_cast<std::size_t>(y) + 1];
+        for (; span != end; ++span)
+        {
+            if (span->kind == SpanKind::Transparent)
+            {
+                continue;
+            }
+            std::memcpy(tile.pixels.data() + static_cast<std::size_t>(cursor) * 4, row + static_cast<std::size_t>(span->start) * 4,
+                static_cast<std::size_t>(span->length) * 4);
+            cursor += static_cast<std::uint32_t>(span->length);
+        }
+    }
+    tile.rowPixels.push_back(cursor);
+    return tile;
+}
+
+void DecompressTile(const RleTile& tile, const SurfaceView& target)
+{
+    for (int y = 0; y < tile.spans.height; ++y)
+    {
+        unsigned char* row = target.pixels + static_cast<std::ptrdiff_t>(y) * target.stride;
+        const unsigned char* stored = tile.pixels.data() + static_cast<std::size_t>(tile.rowPixels[static_cast<std::size_t>(y)]) * 4;
+        const AlphaSpan* span = tile.spans.spans.data() + tile.spans.rowStarts[static_cast<std::size_t>(y)];
+        const AlphaSpan* end = tile.spans.spans.data() + tile.spans.rowStarts[static_cast<std::size_t>(y) + 1];
+        for (; span != end; ++span)
+        {
+            const std::size_t bytes = static_cast<std::size_t>(span->length) * 4;
+            if (span->kind == SpanKind::Transparent)
+            {
+                std::memset(row + static_cast<std::size_t>(span->start) * 4, 0, bytes);
+                continue;
+            }
+            std::memcpy(row + static_cast<std::size_t>(span->start) * 4, stored, bytes);
+            stored += bytes;
+        }
+    }
+}
+
+void CompositeSrcOverRle(const SurfaceView& target, const TileRect& destRect, const RleTile& tile, const TileRect& clip)
+{
+    const TileRect area = IntersectRects(IntersectRects(destRect, clip), TileRect{0, 0, target.width, target.height});
+    if (area.width <= 0 || area.height <= 0)
+    {
+        return;
+    }
+
+    // Clipped columns relative to the tile; the target row pointer starts at the first one.
+    const int first = area.x - destRect.x;
+    const int last = first + area.width;
+    for (int y = area.y; y < area.y + area.height; ++y)
+    {
+        const std::size_t row = static_cast<std::size_t>(y - destRect.y);
+        unsigned char* targetRow = target.pixels + static_cast<std::ptrdiff_t>(y) * target.stride + static_cast<std::ptrdiff_t>(area.x) * 4;
+        const unsigned char* stored = tile.pixels.data() + static_cast<std::size_t>(tile.rowPixels[row]) * 4;
+
+        const AlphaSpan* span = tile.spans.spans.data() + tile.spans.rowStarts[row];
+        const AlphaSpan* end = tile.spans.spans.data() + tile.spans.rowStarts[row + 1];
+        for (; span != end && span->start < last; ++span)
+        {
+            if (span->kind == SpanKind::Transparent)
+            {
+                continue;
+            }
+
+            const int from = std::max(span->start, first);
+            const int to = std::min(span->start + span->length, last);
+            if (from < to)
+            {
+                const unsigned char* source = stored + static_cast<std::size_t>(from - span->start) * 4;
+                unsigned char* destination = targetRow + static_cast<std::size_t>(from - first) * 4;
+                const std::size_t count = static_cast<std::size_t>(to - from);
+                if (span->kind == SpanKind::Opaque)
+                {
+                    std::memcpy(destination, source, count * 4);
+                }
+                else
+                {
+                    BlendSrcOver(source, destination, count);
+                }
+            }
+            stored += static_cast<std::size_t>(span->length) * 4;
+        }
+    }
+}
+} // namespace ui
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Compositor.h"
+#include "SpanTable.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Run-length compressed tiles. A tile keeps its span table and only the pixels of its opaque
+// and partial spans, row after row, so transparent runs cost one span entry instead of four
+// bytes a pixel. Blits read straight from this form; nothing is inflated to draw it.
+namespace ui
+{
+struct RleTile
+{
+    SpanTable spans;                      // its width and height are the tile's
+    std::vector<std::uint32_t> rowPixels; // index of each row's first stored pixel; height + 1 entries
+    std::vector<unsigned char> pixels;    // premultiplied BGRA of the stored spans
+
+    std::size_t ByteSize() const
+    {
+        return spans.ByteSize() + rowPixels.size() * sizeof(std::uint32_t) + pixels.size();
+    }
+};
+
+// Compresses rect of image.
+RleTile CompressTile(const ImageView& image, const TileRect& rect);
+
+// Writes the whole tile into target, which must be the tile's size, transparent runs as zeros.
+void DecompressTile(const RleTile& tile, const SurfaceView& target);
+
+// CompositeSrcOver of the whole tile into destRect, which must be the tile's size, straight
+// from the compressed pixels. Writes exactly what CompositeSrcOver writes.
+void CompositeSrcOverRle(const SurfaceView& target, const TileRect& destRect, const RleTile& tile, const TileRect& clip);
+} // namespace ui
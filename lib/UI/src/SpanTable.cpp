@@ -0,0 +1,59 @@
+#include "SpanTable.h"
+
+#include <cstring>
+
+namespace ui
+{
+namespace
+{
+// Transparent or opaque runs shorter than this are folded into the partial runs around them:
+// the blend kernel handles them inside its SIMD blocks for less than a call of their own.
+constexpr int kMinSkipRun = 8;
+
+SpanKind Classify(const unsigned char* pixel)
+{
+    if (pixel[3] == 255)
+    {
+        return SpanKind::Opaque;
+    }
+    std::uint32_t value;
+    std::memcpy(&value, pixel, sizeof(value));
+    return value == 0 ? SpanKind::Transparent : SpanKind::Partial;
+}
+} // namespace
+
+SpanTable BuildSpanTable(const ImageView& image, const TileRect& rect)
+{
+    SpanTable table;
+    table.width = rect.width;
+    table.height = rect.height;
+    table.rowStarts.reserve(static_cast<std::size_t>(rect.height) + 1);
+    for (int y = 0; y < rect.height; ++y)
+    {
+        table.rowStarts.push_back(static_cast<std::uint32_t>(table.spans.size()));
+        const unsigned char* row = image.pixels + static_cast<std::ptrdiff_t>(rect.y + y) * image.stride + static_cast<std::ptrdiff_t>(rect.x) * 4;
+        for (int x = 0; x < rect.width;)
+        {
+            const SpanKind kind = Classify(row + static_cast<std::size_t>(x) * 4);
+            int end = x + 1;
+            while (end < rect.width && Classify(row + static_cast<std::size_t>(end) * 4) == kind)
+            {
+                ++end;
+            }
+            const SpanKind stored = end - x < kMinSkipRun ? SpanKind::Partial : kind;
+            const std::size_t rowStart = table.rowStarts.back();
+            if (table.spans.size() > rowStart && table.spans.back().kind == stored)
+            {
+                table.spans.back().length += end - x;
+            }
+            else
+            {
+                table.spans.push_back(AlphaSpan{x, end - x, stored});
+            }
+            x = end;
+        }
+    }
+    table.rowStarts.push_back(static_cast<std::uint32_t>(table.spans.size()));
+    return table;
+}
+} // namespace ui
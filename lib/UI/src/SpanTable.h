@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Compositor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-row alpha run tables for premultiplied images. Most tile pixels are fully transparent
+// or fully opaque, and SrcOver needs no arithmetic for either: transparent pixels leave the
+// target alone and opaque ones replace it. RleTile keeps a table per tile and blits from it,
+// skipping the first, copying the second and blending only what is left.
+namespace ui
+{
+enum class SpanKind : std::uint8_t
+{
+    Transparent, // all four bytes zero
+    Opaque,      // alpha 255
+    Partial,
+};
+
+struct AlphaSpan
+{
+    int start; // column relative to the region the table was built for
+    int length;
+    SpanKind kind;
+};
+
+// Spans of row y are spans[rowStarts[y]] up to spans[rowStarts[y + 1]], left to right,
+// covering the row with no gaps.
+struct SpanTable
+{
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint32_t> rowStarts;
+    std::vector<AlphaSpan> spans;
+
+    std::size_t ByteSize() const
+    {
+        return rowStarts.size() * sizeof(std::uint32_t) + spans.size() * sizeof(AlphaSpan);
+    }
+};
+
+// Classifies every pixel of rect in image into runs.
+SpanTable BuildSpanTable(const ImageView& image, const TileRect& rect);
+} // namespace ui
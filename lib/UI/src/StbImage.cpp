@@ -0,0 +1,107 @@
+// Single translation unit carrying the stb_image implementation for every target, with its
+// allocator routed through a per-thread decode target so images land in caller memory.
+#include "ImageDecode.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+// Destination armed by DecodeRgbaInto. The first allocation of exactly its size is the
+// decoder's final output image; every other allocation goes to the heap.
+struct DecodeTarget
+{
+    unsigned char* buffer = nullptr;
+    std::size_t size = 0;
+    bool claimed = false;
+};
+
+thread_local DecodeTarget t_decodeTarget;
+
+void* StbMalloc(std::size_t size)
+{
+    DecodeTarget& target = t_decodeTarget;
+    if (target.buffer != nullptr && !target.claimed && size == target.size)
+    {
+        target.claimed = true;
+        return target.buffer;
+    }
+    return std::malloc(size);
+}
+
+void* StbRealloc(void* pointer, std::size_t size)
+{
+    DecodeTarget& target = t_decodeTarget;
+    if (pointer != nullptr && pointer == target.buffer)
+    {
+        // The decoder wants to grow the buffer it was handed; move it to the heap.
+        void* moved = std::malloc(size);
+        if (moved != nullptr)
+        {
+            std::memcpy(moved, pointer, size < target.size ? size : target.size);
+        }
+        return moved;
+    }
+    return std::realloc(pointer, size);
+}
+
+void StbFree(void* pointer)
+{
+    if (pointer == nullptr || pointer == t_decodeTarget.buffer)
+    {
+        return;
+    }
+    std::free(pointer);
+}
+} // namespace
+
+#define STBI_MALLOC(size) StbMalloc(size)
+#define STBI_REALLOC(pointer, size) StbRealloc(pointer, size)
+#define STBI_FREE(pointer) StbFree(pointer)
+#define STB_IMAGE_IMPLEMENTATION
+#include "../include/stb_image.h"
+
+namespace ui
+{
+void ReadImageSize(const char* path, int& width, int& height)
+{
+    int channels = 0;
+    if (stbi_info(path, &width, &height, &channels) == 0)
+    {
+        throw std::runtime_error(std::string("Failed to read image header: ") + path);
+    }
+}
+
+bool DecodeRgbaInto(const char* path, unsigned char* dst, int width, int height)
+{
+    const std::size_t size = static_cast<std::size_t>(width) * height * 4;
+
+    t_decodeTarget = DecodeTarget{dst, size, false};
+    int decodedWidth = 0;
+    int decodedHeight = 0;
+    int channels = 0;
+    unsigned char* decoded = stbi_load(path, &decodedWidth, &decodedHeight, &channels, 4);
+    t_decodeTarget = DecodeTarget{};
+
+    if (decoded == nullptr)
+    {
+        throw std::runtime_error(std::string("Failed to decode image: ") + path);
+    }
+    if (decoded != dst)
+    {
+        if (decodedWidth == width && decodedHeight == height)
+        {
+            std::memcpy(dst, decoded, size);
+        }
+        std::free(decoded);
+    }
+    if (decodedWidth != width || decodedHeight != height)
+    {
+        throw std::runtime_error(std::string("Image size changed while decoding: ") + path);
+    }
+    return decoded == dst;
+}
+} // namespace ui
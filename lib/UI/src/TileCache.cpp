@@ -0,0 +1,73 @@
+#include "TileCache.h"
+
+#include "Resample.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ui
+{
+std::size_t ScaledTileKeyHash::operator()(const ScaledTileKey& key) const
+{
+    // FNV-1a over the key fields.
+    const std::uint64_t fields[] = {
+        static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key.image)),
+        static_cast<std::uint32_t>(key.source.x),
+        static_cast<std::uint32_t>(key.source.y),
+        static_cast<std::uint32_t>(key.source.width),
+        static_cast<std::uint32_t>(key.source.height),
+        static_cast<std::uint32_t>(key.width),
+        static_cast<std::uint32_t>(key.height)};
+
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const std::uint64_t field : fields)
+    {
+        hash = (hash ^ field) * 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+namespace
+{
+std::shared_ptr<const RleTile> ScaleAndCache(ScaledTileCache& cache, const ScaledTileKey& key, const ImageView& image, const TileRect& source)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(key.width) * key.height * 4);
+    const SurfaceView scaled{pixels.data(), key.width, key.height, key.width * 4};
+    ResampleImage(image, source, scaled);
+
+    auto tile = std::make_shared<RleTile>(CompressTile(ImageView{scaled.pixels, scaled.width, scaled.height, scaled.stride}, TileRect{0, 0, key.width, key.height}));
+    cache.Insert(key, tile, tile->ByteSize());
+    return tile;
+}
+} // namespace
+
+std::shared_ptr<const RleTile> GetScaledTile(ScaledTileCache& cache, const ImageView& image, const TileRect& source, int width, int height)
+{
+    const ScaledTileKey key{image.pixels, source, width, height};
+    if (std::shared_ptr<const RleTile> cached = cache.Find(key))
+    {
+        return cached;
+    }
+    return ScaleAndCache(cache, key, image, source);
+}
+
+std::shared_ptr<const RleTile> GetScaledTile(ScaledTileCache& cache, const RleTile& tile, int width, int height)
+{
+    const TileRect whole{0, 0, tile.spans.width, tile.spans.height};
+    const ScaledTileKey key{&tile, whole, width, height};
+    if (std::shared_ptr<const RleTile> cached = cache.Find(key))
+    {
+        return cached;
+    }
+
+    std::vector<unsigned char> inflated(static_cast<std::size_t>(whole.width) * whole.height * 4);
+    DecompressTile(tile, SurfaceView{inflated.data(), whole.width, whole.height, whole.width * 4});
+    return ScaleAndCache(cache, key, ImageView{inflated.data(), whole.width, whole.height, whole.width * 4}, whole);
+}
+
+ScaledTileCache& SharedTileCache()
+{
+    static ScaledTileCache cache(kDefaultTileCacheBudget);
+    return cache;
+}
+} // namespace ui
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Compositor.h"
+#include "LruCache.h"
+#include "RleTile.h"
+
+#include <cstddef>
+#include <memory>
+
+// Atlas tiles resampled to the size they are drawn at (ResampleImage), so drawing a tile is
+// an unscaled blend. A toggle's size rarely changes, so each scaled copy is made once, and
+// it is kept compressed like the resident tiles.
+namespace ui
+{
+struct ScaledTileKey
+{
+    const void* image; // identifies the source image or tile; sources are immutable
+    TileRect source;
+    int width;
+    int height;
+
+    bool operator==(const ScaledTileKey& other) const
+    {
+        return image == other.image && source.x == other.source.x && source.y == other.source.y &&
+            source.width == other.source.width && source.height == other.source.height && width == other.width &&
+            height == other.height;
+    }
+};
+
+struct ScaledTileKeyHash
+{
+    std::size_t operator()(const ScaledTileKey& key) const;
+};
+
+using ScaledTileCache = LruCache<ScaledTileKey, RleTile, ScaledTileKeyHash>;
+
+constexpr std::size_t kDefaultTileCacheBudget = 4 * 1024 * 1024;
+
+// source of image scaled to width x height, from the cache or resampled and cached.
+std::shared_ptr<const RleTile> GetScaledTile(ScaledTileCache& cache, const ImageView& image, const TileRect& source, int width, int height);
+
+// tile scaled to width x height, from the cache or inflated, resampled and cached.
+std::shared_ptr<const RleTile> GetScaledTile(ScaledTileCache& cache, const RleTile& tile, int width, int height);
+
+// The cache RenderToggle draws through. Entries must be cleared before the atlases they
+// were made from are released.
+ScaledTileCache& SharedTileCache();
+} // namespace ui
@@ -1,52 +1,67 @@
 #include "../include/Toggle.h"
-
-#define STB_IMAGE_IMPLEMENTATION
-#include "../include/stb_image.h"
+#include "AnimationScheduler.h"
+#include "Atlas.h"
+#include "AtlasLoader.h"
+#include "EmbeddedAtlases.h"
+#include "FrameCache.h"
+#include "LoadCoordinator.h"
+#include "TileCache.h"
+#include "ToggleRenderer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
-#include <cstring>
-#include <stdexcept>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
-#pragma comment(lib, "msimg32.lib")
-
 namespace
 {
 constexpr wchar_t kToggleClassName[] = L"UI_TOGGLE_CONTROL";
-constexpr UINT_PTR kAnimationTimerId = 1;
-constexpr int kAnimationStepPixels = 4;
+constexpr UINT kAtlasesReadyMessage = WM_USER + 1; // wParam: TRUE when the atlases loaded
+constexpr UINT kAnimationIntervalMs = 10;
+constexpr int kDefaultAnimationMs = 250;
+constexpr int kMaxAnimationMs = 10000;
 constexpr std::uint32_t kHandleMagic = 0x54474C45; // TGLE
 
-struct TileRect
-{
-    int x;
-    int y;
-    int width;
-    int height;
-};
-
-struct ImageAtlas
-{
-    int width = 0;
-    int height = 0;
-    std::vector<unsigned char> pixels;
-    std::vector<TileRect> tiles;
-};
+using ui::TileRect;
 
 struct ToggleControl;
+} // namespace
 
+// Completes the opaque public handle type; it must live at global scope to match Toggle.h.
 struct UIToggleHandleTag
 {
     std::uint32_t magic = kHandleMagic;
     ToggleControl* control = nullptr;
 };
 
-ImageAtlas g_bodyAtlas;
-ImageAtlas g_switchAtlas;
+namespace
+{
+// Both atlases, immutable once published. Controls on any UI thread read the snapshot
+// through g_atlases.Get() without locking.
+ui::LoadCoordinator<ui::ToggleAtlases> g_atlases;
+// Composed frames of every control, valid for the g_atlases snapshot.
+ui::FrameCache g_frameCache{ui::kDefaultFrameCacheBudget};
+std::mutex g_atlasWaitersMutex;
+std::vector<HWND> g_atlasWaiters;
 HINSTANCE g_moduleInstance = nullptr;
 
+// Animation timer counters of every UI thread, behind UIToggle_GetAnimationStats.
+struct AnimationCounters
+{
+    std::atomic<unsigned long long> wakeups{0};
+    std::atomic<unsigned long long> wastedWakeups{0};
+    std::atomic<unsigned long long> knobMoves{0};
+    std::atomic<unsigned long long> settled{0};
+    std::atomic<int> runningTimers{0};
+};
+AnimationCounters g_animationCounters;
+
+#if !defined(UI_TOGGLE_EMBEDDED_ATLASES)
 std::wstring GetModuleDirectory(HINSTANCE instance)
 {
     wchar_t path[MAX_PATH] = {};
@@ -90,166 +105,250 @@ std::string WideToUtf8(const std::wstring& input)
     return output;
 }
 
+#endif
+
 int Clamp(int value, int minimum, int maximum)
 {
     return std::max(minimum, std::min(maximum, value));
 }
 
-RECT ComputeVisibleBounds(const ImageAtlas& atlas, int index)
+// Decodes both atlases into a new snapshot, or returns nullptr on failure. Only the thread
+// that claimed g_atlases calls it.
+std::unique_ptr<const ui::ToggleAtlases> LoadAtlases()
 {
-    RECT fallback{0, 0, 0, 0};
-    if (index < 0 || index >= static_cast<int>(atlas.tiles.size()))
+    try
     {
-        return fallback;
+#if defined(UI_TOGGLE_EMBEDDED_ATLASES)
+        return ui::LoadToggleAtlases(ui::LoadEmbeddedAtlas);
+#else
+        const std::string assetsDir = WideToUtf8(GetAssetsDirectory());
+        return ui::LoadToggleAtlases([&assetsDir](const ui::AtlasLayout& layout) {
+            return ui::LoadAtlasFromDirectory(assetsDir, layout);
+        });
+#endif
     }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
 
-    const TileRect& tile = atlas.tiles[static_cast<std::size_t>(index)];
-
-    int minX = tile.width;
-    int minY = tile.height;
-    int maxX = 0;
-    int maxY = 0;
-    bool hasVisiblePixel = false;
+// Publishes a load result and tells every control still showing a placeholder.
+void FinishAtlasLoad(std::unique_ptr<const ui::ToggleAtlases> atlases)
+{
+    const bool loaded = atlases != nullptr;
+    g_atlases.Finish(std::move(atlases));
 
-    for (int y = 0; y < tile.height; ++y)
+    std::vector<HWND> waiters;
     {
-        for (int x = 0; x < tile.width; ++x)
-        {
-            const int pxIndex = ((tile.y + y) * atlas.width + (tile.x + x)) * 4;
-            if (atlas.pixels[static_cast<std::size_t>(pxIndex + 3)] > 0)
-            {
-                hasVisiblePixel = true;
-                minX = std::min(minX, x);
-                minY = std::min(minY, y);
-                maxX = std::max(maxX, x);
-                maxY = std::max(maxY, y);
-            }
-        }
+        std::lock_guard<std::mutex> lock(g_atlasWaitersMutex);
+        waiters.swap(g_atlasWaiters);
     }
 
-    if (!hasVisiblePixel)
+    for (HWND waiter : waiters)
     {
-        return RECT{tile.x, tile.y, tile.x + tile.width, tile.y + tile.height};
+        PostMessageW(waiter, kAtlasesReadyMessage, loaded ? TRUE : FALSE, 0);
     }
-
-    return RECT{tile.x + minX, tile.y + minY, tile.x + maxX + 1, tile.y + maxY + 1};
 }
 
-ImageAtlas LoadAtlas(const std::wstring& path, int columns, int rows)
+// Lazy-load texture atlases once and keep them in memory for control instances. Exactly
+// one thread decodes; concurrent callers block until it publishes, as they do while a
+// background preload is in flight.
+bool EnsureAtlasesLoaded()
 {
-    ImageAtlas atlas;
-    const std::string utf8Path = WideToUtf8(path);
-
-    int channels = 0;
-    unsigned char* rawData = stbi_load(utf8Path.c_str(), &atlas.width, &atlas.height, &channels, 4);
-    if (rawData == nullptr)
+    if (g_atlases.Get() != nullptr)
     {
-        throw std::runtime_error("Failed to load atlas image");
+        return true;
     }
 
-    atlas.pixels.assign(rawData, rawData + (atlas.width * atlas.height * 4));
-    stbi_image_free(rawData);
-
-    for (int i = 0; i < atlas.width * atlas.height; ++i)
+    if (g_atlases.TryBegin())
     {
-        unsigned char* pixel = &atlas.pixels[static_cast<std::size_t>(i * 4)];
-        const float alpha = static_cast<float>(pixel[3]) / 255.0f;
-        pixel[0] = static_cast<unsigned char>(pixel[0] * alpha);
-        pixel[1] = static_cast<unsigned char>(pixel[1] * alpha);
-        pixel[2] = static_cast<unsigned char>(pixel[2] * alpha);
+        std::unique_ptr<const ui::ToggleAtlases> atlases = LoadAtlases();
+        const bool loaded = atlases != nullptr;
+        FinishAtlasLoad(std::move(atlases));
+        return loaded;
     }
 
-    const int tileWidth = atlas.width / columns;
-    const int tileHeight = atlas.height / rows;
+    return g_atlases.WaitWhileLoading() != nullptr;
+}
+
+// Non-blocking variant for control paths: succeeds while a preload is still running, in
+// which case controls paint a placeholder until kAtlasesReadyMessage arrives.
+bool RequestAtlases()
+{
+    return g_atlases.IsLoading() || EnsureAtlasesLoaded();
+}
 
-    for (int row = 0; row < rows; ++row)
+// Queues a control created during a preload for kAtlasesReadyMessage.
+void WaitForAtlases(HWND window)
+{
     {
-        for (int col = 0; col < columns; ++col)
+        std::lock_guard<std::mutex> lock(g_atlasWaitersMutex);
+        if (g_atlases.IsLoading())
         {
-            atlas.tiles.push_back(TileRect{col * tileWidth, row * tileHeight, tileWidth, tileHeight});
+            g_atlasWaiters.push_back(window);
+            return;
         }
     }
 
-    return atlas;
+    // The load finished before the control could register; deliver the result directly.
+    PostMessageW(window, kAtlasesReadyMessage, g_atlases.Get() != nullptr ? TRUE : FALSE, 0);
 }
 
-// Lazy-load texture atlases once and keep them in memory for control instances.
-bool EnsureAtlasesLoaded()
+void StopWaitingForAtlases(HWND window)
 {
-    if (!g_bodyAtlas.pixels.empty() && !g_switchAtlas.pixels.empty())
-    {
-        return true;
-    }
+    std::lock_guard<std::mutex> lock(g_atlasWaitersMutex);
+    g_atlasWaiters.erase(std::remove(g_atlasWaiters.begin(), g_atlasWaiters.end(), window), g_atlasWaiters.end());
+}
 
-    try
+DWORD WINAPI PreloadThreadProc(LPVOID module)
+{
+    FinishAtlasLoad(LoadAtlases());
+    FreeLibraryAndExitThread(static_cast<HMODULE>(module), 0);
+    return 0;
+}
+
+// Opaque color behind the tiles: the parent's class background when it is a solid brush,
+// otherwise the button face color.
+std::uint32_t BackgroundColor(HWND window)
+{
+    COLORREF color = GetSysColor(COLOR_BTNFACE);
+    HWND parent = GetParent(window);
+    const ULONG_PTR brush = parent != nullptr ? GetClassLongPtrW(parent, GCLP_HBRBACKGROUND) : 0;
+    if (brush != 0 && brush <= COLOR_MENUBAR + 1)
     {
-        const std::wstring assetsDir = GetAssetsDirectory();
-        g_bodyAtlas = LoadAtlas(assetsDir + L"\\switch-body.png", 5, 2);
-        g_switchAtlas = LoadAtlas(assetsDir + L"\\Switch.png", 3, 2);
-        return true;
+        // Class brushes may be given as a system color index plus one.
+        color = GetSysColor(static_cast<int>(brush - 1));
     }
-    catch (...)
+    else if (brush != 0)
     {
-        g_bodyAtlas = {};
-        g_switchAtlas = {};
-        return false;
+        LOGBRUSH logBrush{};
+        if (GetObjectW(reinterpret_cast<HBRUSH>(brush), sizeof(logBrush), &logBrush) == sizeof(logBrush) && logBrush.lbStyle == BS_SOLID)
+        {
+            color = logBrush.lbColor;
+        }
     }
+
+    return 0xFF000000u | (static_cast<std::uint32_t>(GetRValue(color)) << 16) |
+           (static_cast<std::uint32_t>(GetGValue(color)) << 8) | GetBValue(color);
 }
 
-// Draws one atlas tile with alpha blending into the destination rectangle.
-void DrawTile(HDC hdc, const RECT& destination, const ImageAtlas& atlas, int tileIndex)
+void CALLBACK AnimationTimerProc(HWND, UINT, UINT_PTR, DWORD);
+
+// The animations of every control on one UI thread, advanced together by a single thread
+// timer that exists only while one of them is moving.
+struct ThreadAnimations
 {
-    if (tileIndex < 0 || tileIndex >= static_cast<int>(atlas.tiles.size()))
+    UINT_PTR timer = 0;
+    ui::AnimationScheduler scheduler{ui::SteadyClockMicroseconds, [this](bool ticking) { SetTicking(ticking); }};
+
+    ~ThreadAnimations()
     {
-        return;
+        SetTicking(false);
     }
 
-    const RECT crop = ComputeVisibleBounds(atlas, tileIndex);
-    const int srcWidth = crop.right - crop.left;
-    const int srcHeight = crop.bottom - crop.top;
+    void SetTicking(bool ticking)
+    {
+        if (ticking && timer == 0)
+        {
+            timer = SetTimer(nullptr, 0, kAnimationIntervalMs, AnimationTimerProc);
+            g_animationCounters.runningTimers += timer != 0 ? 1 : 0;
+        }
+        else if (!ticking && timer != 0)
+        {
+            KillTimer(nullptr, timer);
+            timer = 0;
+            --g_animationCounters.runningTimers;
+        }
+    }
+};
 
-    BITMAPINFO bmi{};
-    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = atlas.width;
-    bmi.bmiHeader.biHeight = -atlas.height;
-    bmi.bmiHeader.biPlanes = 1;
-    bmi.bmiHeader.biBitCount = 32;
-    bmi.bmiHeader.biCompression = BI_RGB;
+// Windows belong to the thread that created them, so each UI thread schedules its own.
+ThreadAnimations& CurrentThreadAnimations()
+{
+    thread_local ThreadAnimations animations;
+    return animations;
+}
 
-    void* bits = nullptr;
-    HBITMAP bitmap = CreateDIBSection(hdc, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
-    if (bitmap == nullptr)
+// Persistent per-control frame: a top-down 32-bit DIB section kept selected into a memory
+// DC. Frames are composed straight into its bits and presented with one BitBlt. Recreated
+// only when the client size changes. Non-copyable; releases its GDI objects on destruction.
+struct BackBuffer
+{
+    HDC memoryDc = nullptr;
+    HBITMAP bitmap = nullptr;
+    HBITMAP previousBitmap = nullptr;
+    unsigned char* bits = nullptr;
+    int width = 0;
+    int height = 0;
+
+    BackBuffer() = default;
+    BackBuffer(const BackBuffer&) = delete;
+    BackBuffer& operator=(const BackBuffer&) = delete;
+
+    ~BackBuffer()
     {
-        return;
+        Release();
     }
 
-    std::memcpy(bits, atlas.pixels.data(), atlas.pixels.size());
+    // Makes the buffer width x height, keeping the existing one when the size matches.
+    bool Ensure(int newWidth, int newHeight)
+    {
+        if (bitmap != nullptr && width == newWidth && height == newHeight)
+        {
+            return true;
+        }
 
-    HDC memoryDc = CreateCompatibleDC(hdc);
-    HBITMAP oldBitmap = static_cast<HBITMAP>(SelectObject(memoryDc, bitmap));
+        Release();
 
-    BLENDFUNCTION blend{};
-    blend.BlendOp = AC_SRC_OVER;
-    blend.SourceConstantAlpha = 255;
-    blend.AlphaFormat = AC_SRC_ALPHA;
+        BITMAPINFO bmi{};
+        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bmi.bmiHeader.biWidth = newWidth;
+        bmi.bmiHeader.biHeight = -newHeight;
+        bmi.bmiHeader.biPlanes = 1;
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB;
 
-    AlphaBlend(
-        hdc,
-        destination.left,
-        destination.top,
-        destination.right - destination.left,
-        destination.bottom - destination.top,
-        memoryDc,
-        crop.left,
-        crop.top,
-        srcWidth,
-        srcHeight,
-        blend);
+        void* dibBits = nullptr;
+        bitmap = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &dibBits, nullptr, 0);
+        memoryDc = bitmap != nullptr ? CreateCompatibleDC(nullptr) : nullptr;
+        if (memoryDc == nullptr)
+        {
+            Release();
+            return false;
+        }
 
-    SelectObject(memoryDc, oldBitmap);
-    DeleteDC(memoryDc);
-    DeleteObject(bitmap);
-}
+        previousBitmap = static_cast<HBITMAP>(SelectObject(memoryDc, bitmap));
+        bits = static_cast<unsigned char*>(dibBits);
+        width = newWidth;
+        height = newHeight;
+        return true;
+    }
+
+    ui::SurfaceView Surface() const
+    {
+        return ui::SurfaceView{bits, width, height, width * 4};
+    }
+
+    void Release()
+    {
+        if (memoryDc != nullptr)
+        {
+            SelectObject(memoryDc, previousBitmap);
+            DeleteDC(memoryDc);
+        }
+        if (bitmap != nullptr)
+        {
+            DeleteObject(bitmap);
+        }
+        memoryDc = nullptr;
+        bitmap = nullptr;
+        previousBitmap = nullptr;
+        bits = nullptr;
+        width = 0;
+        height = 0;
+    }
+};
 
 struct ToggleControl
 {
@@ -259,6 +358,13 @@ struct ToggleControl
     int targetOffset = 0;
     int switchStyle = 0;
     int bodyStyle = 0;
+    ui::AnimationCurve animation{ui::Easing::Linear, kDefaultAnimationMs * 1000ull};
+    bool springAnimation = false; // spring in place of animation, see UIToggle_SetSpringAnimation
+    ui::SpringParams spring;
+    BackBuffer backBuffer;
+    std::uint32_t bufferBackground = 0;                // background the back buffer was painted over
+    const ui::ToggleAtlases* bufferAtlases = nullptr; // snapshot the back buffer was painted from
+    UITogglePaintStats paintStats{};
 
     static LRESULT CALLBACK WindowProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
     {
@@ -283,17 +389,19 @@ struct ToggleControl
             case WM_LBUTTONDOWN:
                 self->SetChecked(self->state == UI_TOGGLE_STATE_OFF, TRUE);
                 return 0;
-            case WM_TIMER:
-                if (wParam == kAnimationTimerId)
-                {
-                    self->AnimateStep();
-                }
-                return 0;
+            case WM_ERASEBKGND:
+                // OnPaint covers every pixel; erasing first would only flicker.
+                return 1;
             case WM_PAINT:
                 self->OnPaint();
                 return 0;
+            case kAtlasesReadyMessage:
+                self->OnAtlasesReady(wParam != FALSE);
+                return 0;
             case WM_NCDESTROY:
-                KillTimer(hwnd, kAnimationTimerId);
+                CurrentThreadAnimations().scheduler.Cancel(self);
+                StopWaitingForAtlases(hwnd);
+                self->backBuffer.Release();
                 self->window = nullptr;
                 return DefWindowProcW(hwnd, message, wParam, lParam);
             default:
@@ -304,15 +412,31 @@ struct ToggleControl
     // Updates state, starts animation, and optionally notifies the parent window.
     bool SetChecked(BOOL checked, BOOL notifyParent)
     {
-        if (!EnsureAtlasesLoaded() || window == nullptr)
+        if (!RequestAtlases() || window == nullptr)
         {
             return false;
         }
 
         state = checked ? UI_TOGGLE_STATE_ON : UI_TOGGLE_STATE_OFF;
-        const int travel = g_switchAtlas.tiles.empty() ? 0 : g_switchAtlas.tiles[0].width;
+        const int travel = ui::KnobTravel(g_atlases.Get());
         targetOffset = checked ? travel : 0;
-        SetTimer(window, kAnimationTimerId, 10, nullptr);
+
+        if (springAnimation)
+        {
+            // The spring keeps the knob's velocity, so rapid clicks turn it around smoothly.
+            CurrentThreadAnimations().scheduler.AnimateSpring(this, knobOffset, targetOffset, spring);
+        }
+        else
+        {
+            // A reversal mid-flight covers part of the travel in the same part of the duration.
+            ui::AnimationCurve curve = animation;
+            if (travel > 0)
+            {
+                const int distance = std::min(travel, std::abs(targetOffset - knobOffset));
+                curve.durationMicroseconds = curve.durationMicroseconds * static_cast<std::uint64_t>(distance) / static_cast<std::uint64_t>(travel);
+            }
+            CurrentThreadAnimations().scheduler.Animate(this, knobOffset, targetOffset, curve);
+        }
 
         if (notifyParent)
         {
@@ -322,43 +446,135 @@ struct ToggleControl
         return true;
     }
 
-    void AnimateStep()
+    // Takes the knob position from a scheduler tick and repaints only the strip it swept.
+    void OnAnimationUpdate(const ui::AnimationUpdate& update)
     {
-        if (knobOffset < targetOffset)
-        {
-            knobOffset = std::min(knobOffset + kAnimationStepPixels, targetOffset);
-        }
-        else if (knobOffset > targetOffset)
+        knobOffset = update.current;
+        InvalidateKnobSweep(update.previous, update.current);
+    }
+
+    // Invalidates the union of the knob rectangles at two offsets.
+    void InvalidateKnobSweep(int fromOffset, int toOffset)
+    {
+        RECT client{};
+        GetClientRect(window, &client);
+        const int width = static_cast<int>(client.right - client.left);
+        const int height = static_cast<int>(client.bottom - client.top);
+        const ui::ToggleAtlases* atlases = g_atlases.Get();
+        const TileRect damage = ui::UnionRects(
+            ui::KnobRect(atlases, switchStyle, width, height, fromOffset), ui::KnobRect(atlases, switchStyle, width, height, toOffset));
+        if (damage.width <= 0 || damage.height <= 0)
         {
-            knobOffset = std::max(knobOffset - kAnimationStepPixels, targetOffset);
+            return;
         }
-        else
+
+        const RECT rect{damage.x, damage.y, damage.x + damage.width, damage.y + damage.height};
+        InvalidateRect(window, &rect, FALSE);
+    }
+
+    // A background preload finished: settle the knob and drop the placeholder. A failed
+    // preload is retried synchronously; should that fail too, the placeholder stays and the
+    // next SetChecked tries again.
+    void OnAtlasesReady(bool loaded)
+    {
+        if (!loaded && !EnsureAtlasesLoaded())
         {
-            KillTimer(window, kAnimationTimerId);
+            return;
         }
 
-        InvalidateRect(window, nullptr, TRUE);
+        CurrentThreadAnimations().scheduler.Cancel(this);
+        targetOffset = (state == UI_TOGGLE_STATE_ON) ? ui::KnobTravel(g_atlases.Get()) : 0;
+        knobOffset = targetOffset;
+        InvalidateRect(window, nullptr, FALSE);
     }
 
+    // Refreshes the invalid part of the back buffer from the shared frame cache, or renders
+    // just that part on a miss, and presents it with a single blit. Until the atlases arrive
+    // the invalid part is rendered as a placeholder.
     void OnPaint()
     {
         PAINTSTRUCT paint{};
         HDC hdc = BeginPaint(window, &paint);
 
-        RECT bounds{};
-        GetClientRect(window, &bounds);
+        RECT client{};
+        GetClientRect(window, &client);
+        const TileRect bounds{0, 0, static_cast<int>(client.right - client.left), static_cast<int>(client.bottom - client.top)};
+        const bool resized = bounds.width != backBuffer.width || bounds.height != backBuffer.height;
+        if (bounds.width > 0 && bounds.height > 0 && backBuffer.Ensure(bounds.width, bounds.height))
+        {
+            // A new buffer, or one painted over another background or from other atlases, holds
+            // no part of this frame, so it is composed in full.
+            const std::uint32_t background = BackgroundColor(window);
+            const ui::ToggleAtlases* atlases = g_atlases.Get();
+            const bool stale = resized || background != bufferBackground || atlases != bufferAtlases;
+            const TileRect invalid{
+                static_cast<int>(paint.rcPaint.left),
+                static_cast<int>(paint.rcPaint.top),
+                static_cast<int>(paint.rcPaint.right - paint.rcPaint.left),
+                static_cast<int>(paint.rcPaint.bottom - paint.rcPaint.top)};
+            const TileRect clip = stale ? bounds : ui::IntersectRects(bounds, invalid);
+            if (clip.width > 0 && clip.height > 0)
+            {
+                // GDI may still be reading the DIB from the previous present.
+                GdiFlush();
+
+                ui::ToggleAppearance appearance;
+                appearance.bodyStyle = bodyStyle;
+                appearance.switchStyle = switchStyle;
+                appearance.knobOffset = knobOffset;
+                int composedPixels = clip.width * clip.height;
+                if (atlases != nullptr)
+                {
+                    composedPixels = ui::PaintFrame(g_frameCache, backBuffer.Surface(), clip, *atlases, appearance, background);
+                }
+                else
+                {
+                    ui::RenderToggle(backBuffer.Surface(), clip, background, atlases, appearance);
+                }
+                bufferBackground = background;
+                bufferAtlases = atlases;
 
-        DrawTile(hdc, bounds, g_bodyAtlas, bodyStyle);
+                BitBlt(hdc, clip.x, clip.y, clip.width, clip.height, backBuffer.memoryDc, clip.x, clip.y, SRCCOPY);
 
-        RECT knob = bounds;
-        knob.left += knobOffset;
-        knob.right += knobOffset;
-        DrawTile(hdc, knob, g_switchAtlas, switchStyle);
+                ++paintStats.frames;
+                paintStats.last_frame_pixels = composedPixels;
+                paintStats.pixels_touched += static_cast<unsigned long long>(paintStats.last_frame_pixels);
+                paintStats.client_pixels = bounds.width * bounds.height;
+            }
+        }
 
         EndPaint(window, &paint);
     }
 };
 
+// Advances every animating control of the calling thread by one scheduler tick. Only knobs
+// that moved by a whole pixel are invalidated; the tick that lands the last one on its target
+// also stops the timer.
+void CALLBACK AnimationTimerProc(HWND, UINT, UINT_PTR, DWORD)
+{
+    ui::AnimationScheduler& scheduler = CurrentThreadAnimations().scheduler;
+    const std::uint64_t settledBefore = scheduler.Stats().settled;
+    const std::vector<ui::AnimationUpdate>& updates = scheduler.Tick();
+    for (const ui::AnimationUpdate& update : updates)
+    {
+        static_cast<ToggleControl*>(update.owner)->OnAnimationUpdate(update);
+    }
+
+    ++g_animationCounters.wakeups;
+    g_animationCounters.wastedWakeups += updates.empty() ? 1 : 0;
+    g_animationCounters.knobMoves += updates.size();
+    g_animationCounters.settled += scheduler.Stats().settled - settledBefore;
+}
+
+void CopyCacheStats(const ui::CacheStats& cache, UIToggleCacheStats* stats)
+{
+    stats->hits = cache.hits;
+    stats->misses = cache.misses;
+    stats->bytes_used = cache.bytesUsed;
+    stats->byte_budget = cache.byteBudget;
+    stats->entries = static_cast<int>(cache.entries);
+}
+
 bool IsValidHandle(UIToggleHandle handle)
 {
     return handle != nullptr && handle->magic == kHandleMagic && handle->control != nullptr;
@@ -366,13 +582,20 @@ bool IsValidHandle(UIToggleHandle handle)
 
 } // namespace
 
-BOOL APIENTRY DllMain(HINSTANCE instance, DWORD reason, LPVOID)
+BOOL APIENTRY DllMain(HINSTANCE instance, DWORD reason, LPVOID reserved)
 {
     if (reason == DLL_PROCESS_ATTACH)
     {
         g_moduleInstance = instance;
         DisableThreadLibraryCalls(instance);
     }
+    else if (reason == DLL_PROCESS_DETACH && reserved == nullptr)
+    {
+        // FreeLibrary unload: release the compressed atlases and caches. On process exit the OS reclaims them.
+        g_frameCache.Clear();
+        ui::SharedTileCache().Clear();
+        g_atlases.Reset();
+    }
     return TRUE;
 }
 
@@ -381,6 +604,8 @@ extern "C" BOOL UIToggle_RegisterClass(HINSTANCE instance)
     HINSTANCE classInstance = instance != nullptr ? instance : g_moduleInstance;
 
     WNDCLASSW wc{};
+    // The body stretches with the client area, so any resize repaints the whole frame.
+    wc.style = CS_HREDRAW | CS_VREDRAW;
     wc.lpfnWndProc = ToggleControl::WindowProc;
     wc.hInstance = classInstance;
     wc.lpszClassName = kToggleClassName;
@@ -395,6 +620,38 @@ extern "C" BOOL UIToggle_RegisterClass(HINSTANCE instance)
     return GetLastError() == ERROR_CLASS_ALREADY_EXISTS;
 }
 
+// Starts decoding the atlases on a worker thread so the first control does not stall the
+// UI thread. The worker holds its own module reference, so FreeLibrary cannot unmap the
+// DLL underneath it.
+extern "C" BOOL UIToggle_PreloadAsync(void)
+{
+    if (!g_atlases.TryBegin())
+    {
+        return TRUE;
+    }
+
+    HMODULE module = nullptr;
+    if (!GetModuleHandleExW(
+            GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
+            reinterpret_cast<LPCWSTR>(&PreloadThreadProc),
+            &module))
+    {
+        FinishAtlasLoad(nullptr);
+        return FALSE;
+    }
+
+    HANDLE thread = CreateThread(nullptr, 0, PreloadThreadProc, module, 0, nullptr);
+    if (thread == nullptr)
+    {
+        FreeLibrary(module);
+        FinishAtlasLoad(nullptr);
+        return FALSE;
+    }
+
+    CloseHandle(thread);
+    return TRUE;
+}
+
 extern "C" UIToggleHandle UIToggle_Create(const UIToggleCreateParams* params)
 {
     if (params == nullptr || params->parent == nullptr)
@@ -402,7 +659,7 @@ extern "C" UIToggleHandle UIToggle_Create(const UIToggleCreateParams* params)
         return nullptr;
     }
 
-    if (!EnsureAtlasesLoaded())
+    if (!RequestAtlases())
     {
         return nullptr;
     }
@@ -432,6 +689,11 @@ extern "C" UIToggleHandle UIToggle_Create(const UIToggleCreateParams* params)
         return nullptr;
     }
 
+    if (g_atlases.Get() == nullptr)
+    {
+        WaitForAtlases(hwnd);
+    }
+
     return handle;
 }
 
@@ -476,33 +738,83 @@ extern "C" BOOL UIToggle_GetChecked(UIToggleHandle handle, BOOL* checked)
     return TRUE;
 }
 
-// Applies a clamped switch-knob style index from the loaded switch atlas.
+// Applies a clamped switch-knob style index from the switch atlas layout.
 extern "C" BOOL UIToggle_SetSwitchStyle(UIToggleHandle handle, int style_index)
 {
-    if (!IsValidHandle(handle) || !EnsureAtlasesLoaded())
+    if (!IsValidHandle(handle) || !RequestAtlases())
     {
         return FALSE;
     }
 
     ToggleControl* control = handle->control;
-    const int maxStyle = static_cast<int>(g_switchAtlas.tiles.size()) - 1;
-    control->switchStyle = Clamp(style_index, 0, maxStyle);
-    InvalidateRect(control->window, nullptr, TRUE);
+    const int maxStyle = ui::kSwitchAtlasLayout.columns * ui::kSwitchAtlasLayout.rows - 1;
+    const int style = Clamp(style_index, 0, maxStyle);
+    if (style != control->switchStyle)
+    {
+        control->switchStyle = style;
+        InvalidateRect(control->window, nullptr, FALSE);
+    }
     return TRUE;
 }
 
-// Applies a clamped body style index from the loaded body atlas.
+// Applies a clamped body style index from the body atlas layout.
 extern "C" BOOL UIToggle_SetBodyStyle(UIToggleHandle handle, int style_index)
 {
-    if (!IsValidHandle(handle) || !EnsureAtlasesLoaded())
+    if (!IsValidHandle(handle) || !RequestAtlases())
+    {
+        return FALSE;
+    }
+
+    ToggleControl* control = handle->control;
+    const int maxStyle = ui::kBodyAtlasLayout.columns * ui::kBodyAtlasLayout.rows - 1;
+    const int style = Clamp(style_index, 0, maxStyle);
+    if (style != control->bodyStyle)
+    {
+        control->bodyStyle = style;
+        InvalidateRect(control->window, nullptr, FALSE);
+    }
+    return TRUE;
+}
+
+extern "C" BOOL UIToggle_SetAnimation(UIToggleHandle handle, UIToggleEasing easing, int duration_ms)
+{
+    if (!IsValidHandle(handle) || duration_ms < 0 || duration_ms > kMaxAnimationMs)
+    {
+        return FALSE;
+    }
+
+    ui::AnimationCurve curve;
+    switch (easing)
+    {
+        case UI_TOGGLE_EASING_LINEAR:
+            curve.easing = ui::Easing::Linear;
+            break;
+        case UI_TOGGLE_EASING_CUBIC:
+            curve.easing = ui::Easing::Cubic;
+            break;
+        case UI_TOGGLE_EASING_SPRING:
+            curve.easing = ui::Easing::Spring;
+            break;
+        default:
+            return FALSE;
+    }
+    curve.durationMicroseconds = static_cast<std::uint64_t>(duration_ms) * 1000;
+    handle->control->animation = curve;
+    handle->control->springAnimation = false;
+    return TRUE;
+}
+
+extern "C" BOOL UIToggle_SetSpringAnimation(UIToggleHandle handle, int settle_ms, float rest_pixels)
+{
+    if (!IsValidHandle(handle) || settle_ms <= 0 || settle_ms > kMaxAnimationMs || !(rest_pixels > 0.0f) || !std::isfinite(rest_pixels))
     {
         return FALSE;
     }
 
     ToggleControl* control = handle->control;
-    const int maxStyle = static_cast<int>(g_bodyAtlas.tiles.size()) - 1;
-    control->bodyStyle = Clamp(style_index, 0, maxStyle);
-    InvalidateRect(control->window, nullptr, TRUE);
+    control->spring.angularFrequency = ui::SpringFrequencyForSettleTime(static_cast<std::uint64_t>(settle_ms) * 1000);
+    control->spring.restDistance = rest_pixels;
+    control->springAnimation = true;
     return TRUE;
 }
 
@@ -516,3 +828,92 @@ extern "C" BOOL UIToggle_GetWindow(UIToggleHandle handle, HWND* out_window)
     *out_window = handle->control->window;
     return TRUE;
 }
+
+extern "C" BOOL UIToggle_GetPaintStats(UIToggleHandle handle, UITogglePaintStats* stats)
+{
+    if (!IsValidHandle(handle) || stats == nullptr)
+    {
+        return FALSE;
+    }
+
+    *stats = handle->control->paintStats;
+    return TRUE;
+}
+
+extern "C" BOOL UIToggle_GetAnimationStats(UIToggleAnimationStats* stats)
+{
+    if (stats == nullptr)
+    {
+        return FALSE;
+    }
+
+    stats->timer_wakeups = g_animationCounters.wakeups;
+    stats->wasted_wakeups = g_animationCounters.wastedWakeups;
+    stats->knob_moves = g_animationCounters.knobMoves;
+    stats->settled = g_animationCounters.settled;
+    stats->running_timers = g_animationCounters.runningTimers;
+    return TRUE;
+}
+
+extern "C" BOOL UIToggle_GetFrameCacheStats(UIToggleCacheStats* stats)
+{
+    if (stats == nullptr)
+    {
+        return FALSE;
+    }
+
+    CopyCacheStats(g_frameCache.Stats(), stats);
+    return TRUE;
+}
+
+// Bounds the memory of the shared frame cache, evicting least recently used frames at once.
+// Zero disables it: every paint composes its frame.
+extern "C" BOOL UIToggle_SetFrameCacheBudget(unsigned long long byte_budget)
+{
+    g_frameCache.SetByteBudget(static_cast<std::size_t>(std::min<unsigned long long>(byte_budget, SIZE_MAX)));
+    return TRUE;
+}
+
+extern "C" int UIToggle_GetTileCacheStats(UIToggleCacheStats* stats)
+{
+    if (stats == nullptr)
+    {
+        return FALSE;
+    }
+
+    CopyCacheStats(ui::SharedTileCache().Stats(), stats);
+    return TRUE;
+}
+
+extern "C" int UIToggle_SetTileCacheBudget(unsigned long long byte_budget)
+{
+    ui::SharedTileCache().SetByteBudget(static_cast<std::size_t>(std::min<unsigned long long>(byte_budget, SIZE_MAX)));
+    return TRUE;
+}
+
+// Renders through the same path as the controls, without a window. Blocks until the
+// atlases are loaded, waiting out a background preload if one is running.
+extern "C" int UIToggle_RenderToBuffer(const UIToggleRenderParams* params, void* pixels, int width, int height, int stride)
+{
+    if (params == nullptr || !EnsureAtlasesLoaded())
+    {
+        return FALSE;
+    }
+
+    ui::ToggleAppearance appearance;
+    appearance.bodyStyle = params->body_style;
+    appearance.switchStyle = params->switch_style;
+    appearance.knobOffset = params->knob_offset;
+    return ui::RenderToggleToBuffer(g_atlases.Get(), appearance, params->background, pixels, width, height, stride) ? TRUE : FALSE;
+}
+
+extern "C" int UIToggle_GetKnobTravel(int* travel)
+{
+    if (travel == nullptr || !EnsureAtlasesLoaded())
+    {
+        return FALSE;
+    }
+
+    *travel = ui::KnobTravel(g_atlases.Get());
+    return TRUE;
+}
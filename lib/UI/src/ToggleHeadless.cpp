@@ -0,0 +1,128 @@
+// Headless backend for platforms without the Win32 DLL: the UIToggleHeadless shared library
+// exporting the rendering API from ToggleRender.h. Like the DLL, it loads the atlases from
+// assets/Troggle next to the library (or uses the embedded ones) and renders through
+// ui::RenderToggle, so its output is pixel-identical to a control's paint.
+#include "../include/ToggleRender.h"
+#include "AtlasLoader.h"
+#include "EmbeddedAtlases.h"
+#include "LoadCoordinator.h"
+#include "TileCache.h"
+#include "ToggleRenderer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if !defined(UI_TOGGLE_EMBEDDED_ATLASES)
+#include <dlfcn.h>
+#endif
+
+namespace
+{
+ui::LoadCoordinator<ui::ToggleAtlases> g_atlases;
+
+#if !defined(UI_TOGGLE_EMBEDDED_ATLASES)
+// Directory holding this shared library, found through one of its own symbols.
+std::string GetModuleDirectory()
+{
+    Dl_info info{};
+    if (dladdr(reinterpret_cast<void*>(&GetModuleDirectory), &info) == 0 || info.dli_fname == nullptr)
+    {
+        return ".";
+    }
+
+    const std::string path(info.dli_fname);
+    const std::size_t pos = path.find_last_of('/');
+    if (pos == std::string::npos)
+    {
+        return ".";
+    }
+    return path.substr(0, pos);
+}
+#endif
+
+std::unique_ptr<const ui::ToggleAtlases> LoadAtlases()
+{
+    try
+    {
+#if defined(UI_TOGGLE_EMBEDDED_ATLASES)
+        return ui::LoadToggleAtlases(ui::LoadEmbeddedAtlas);
+#else
+        const std::string assetsDir = GetModuleDirectory() + "/assets/Troggle";
+        return ui::LoadToggleAtlases([&assetsDir](const ui::AtlasLayout& layout) {
+            return ui::LoadAtlasFromDirectory(assetsDir, layout);
+        });
+#endif
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+// Loads the atlases once; concurrent callers wait for the first. Null when loading failed.
+const ui::ToggleAtlases* EnsureAtlasesLoaded()
+{
+    if (const ui::ToggleAtlases* atlases = g_atlases.Get())
+    {
+        return atlases;
+    }
+
+    if (g_atlases.TryBegin())
+    {
+        g_atlases.Finish(LoadAtlases());
+        return g_atlases.Get();
+    }
+
+    return g_atlases.WaitWhileLoading();
+}
+} // namespace
+
+extern "C" int UIToggle_RenderToBuffer(const UIToggleRenderParams* params, void* pixels, int width, int height, int stride)
+{
+    if (params == nullptr)
+    {
+        return 0;
+    }
+
+    ui::ToggleAppearance appearance;
+    appearance.bodyStyle = params->body_style;
+    appearance.switchStyle = params->switch_style;
+    appearance.knobOffset = params->knob_offset;
+    return ui::RenderToggleToBuffer(EnsureAtlasesLoaded(), appearance, params->background, pixels, width, height, stride) ? 1 : 0;
+}
+
+extern "C" int UIToggle_GetKnobTravel(int* travel)
+{
+    const ui::ToggleAtlases* atlases = travel != nullptr ? EnsureAtlasesLoaded() : nullptr;
+    if (atlases == nullptr)
+    {
+        return 0;
+    }
+
+    *travel = ui::KnobTravel(atlases);
+    return 1;
+}
+
+extern "C" int UIToggle_GetTileCacheStats(UIToggleCacheStats* stats)
+{
+    if (stats == nullptr)
+    {
+        return 0;
+    }
+
+    const ui::CacheStats cache = ui::SharedTileCache().Stats();
+    stats->hits = cache.hits;
+    stats->misses = cache.misses;
+    stats->bytes_used = cache.bytesUsed;
+    stats->byte_budget = cache.byteBudget;
+    stats->entries = static_cast<int>(cache.entries);
+    return 1;
+}
+
+extern "C" int UIToggle_SetTileCacheBudget(unsigned long long byte_budget)
+{
+    ui::SharedTileCache().SetByteBudget(static_cast<std::size_t>(std::min<unsigned long long>(byte_budget, SIZE_MAX)));
+    return 1;
+}
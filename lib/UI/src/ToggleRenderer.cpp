@@ -0,0 +1,114 @@
+#include "ToggleRenderer.h"
+
+#include "TileCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+namespace ui
+{
+namespace
+{
+void DrawTile(const SurfaceView& target, const TileRect& destination, const TileRect& clip, const ImageAtlas& atlas, int tileIndex)
+{
+    if (tileIndex < 0 || tileIndex >= static_cast<int>(atlas.compressed.size()))
+    {
+        return;
+    }
+
+    // Scaling is done once per size; every frame after that blends 1:1 from a compressed tile.
+    const std::size_t index = static_cast<std::size_t>(tileIndex);
+    if (index < atlas.mips.size())
+    {
+        if (const MipLevel* level = SelectMipLevel(atlas.mips[index], destination.width, destination.height))
+        {
+            const ImageView levelView{level->pixels.data(), level->width, level->height, level->width * 4};
+            const TileRect levelRect{0, 0, level->width, level->height};
+            if (level->width == destination.width && level->height == destination.height)
+            {
+                CompositeSrcOver(target, destination, levelView, levelRect, clip);
+                return;
+            }
+            CompositeSrcOverRle(target, destination, *GetScaledTile(SharedTileCache(), levelView, levelRect, destination.width, destination.height), clip);
+            return;
+        }
+    }
+
+    const RleTile& tile = atlas.compressed[index];
+    if (tile.spans.width == destination.width && tile.spans.height == destination.height)
+    {
+        CompositeSrcOverRle(target, destination, tile, clip);
+        return;
+    }
+    CompositeSrcOverRle(target, destination, *GetScaledTile(SharedTileCache(), tile, destination.width, destination.height), clip);
+}
+} // namespace
+
+int KnobTravel(const ToggleAtlases* atlases)
+{
+    if (atlases == nullptr || atlases->knob.tiles.empty())
+    {
+        return 0;
+    }
+    return atlases->knob.tiles[0].width;
+}
+
+TileRect KnobRect(const ToggleAtlases* atlases, int switchStyle, int width, int height, int knobOffset)
+{
+    if (atlases == nullptr || switchStyle < 0 || switchStyle >= static_cast<int>(atlases->knob.compressed.size()))
+    {
+        return TileRect{0, 0, 0, 0};
+    }
+    return IntersectRects(TileRect{knobOffset, 0, width, height}, TileRect{0, 0, width, height});
+}
+
+void RenderToggle(
+    const SurfaceView& target,
+    const TileRect& clip,
+    std::uint32_t background,
+    const ToggleAtlases* atlases,
+    const ToggleAppearance& appearance)
+{
+    const TileRect bounds{0, 0, target.width, target.height};
+    FillSurface(target, IntersectRects(bounds, clip), background);
+    if (atlases == nullptr)
+    {
+        return;
+    }
+
+    DrawTile(target, bounds, clip, atlases->body, appearance.bodyStyle);
+
+    TileRect knob = bounds;
+    knob.x += appearance.knobOffset;
+    DrawTile(target, knob, clip, atlases->knob, appearance.switchStyle);
+}
+
+bool RenderToggleToBuffer(
+    const ToggleAtlases* atlases,
+    ToggleAppearance appearance,
+    std::uint32_t background,
+    void* pixels,
+    int width,
+    int height,
+    int stride)
+{
+    if (atlases == nullptr || pixels == nullptr || width <= 0 || height <= 0 ||
+        width > std::numeric_limits<int>::max() / 4 || stride < width * 4)
+    {
+        return false;
+    }
+
+    const int maxBodyStyle = kBodyAtlasLayout.columns * kBodyAtlasLayout.rows - 1;
+    const int maxSwitchStyle = kSwitchAtlasLayout.columns * kSwitchAtlasLayout.rows - 1;
+    appearance.bodyStyle = std::max(0, std::min(maxBodyStyle, appearance.bodyStyle));
+    appearance.switchStyle = std::max(0, std::min(maxSwitchStyle, appearance.switchStyle));
+    // Any offset past either edge puts the knob wholly outside the buffer.
+    appearance.knobOffset = std::max(-width, std::min(width, appearance.knobOffset));
+
+    const SurfaceView target{static_cast<unsigned char*>(pixels), width, height, stride};
+    RenderToggle(target, TileRect{0, 0, width, height}, background, atlases, appearance);
+    return true;
+}
+} // namespace ui
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AtlasLoader.h"
+#include "Compositor.h"
+
+#include <cstdint>
+
+// Backend-neutral toggle painting. A backend provides a SurfaceView, RenderToggle fills it,
+// and the backend presents it: the Win32 control copies it to its window, the headless
+// backend (UIToggle_RenderToBuffer) renders into caller memory.
+namespace ui
+{
+struct ToggleAppearance
+{
+    int bodyStyle = 0;
+    int switchStyle = 0;
+    int knobOffset = 0; // pixels right of the off position, see KnobTravel
+};
+
+// Knob offset of the on position; zero without atlases.
+int KnobTravel(const ToggleAtlases* atlases);
+
+// Pixels of a width x height toggle the knob layer covers at knobOffset: the client area
+// shifted by knobOffset, as RenderToggle draws it; empty without atlases or for an
+// out-of-range style. Only these change when the knob moves, so a step from one offset to
+// another repaints the union of both.
+TileRect KnobRect(const ToggleAtlases* atlases, int switchStyle, int width, int height, int knobOffset);
+
+// Paints a toggle covering the whole surface: an opaque background (0xAARRGGBB), the body
+// tile stretched over the surface, then the knob tile over the same rectangle shifted by
+// knobOffset. Tiles are resampled with ResampleImage through SharedTileCache(), starting
+// from the smallest mip level that still covers the drawn size.
+// Without atlases only the background is painted, which is the placeholder.
+// Only pixels inside clip are written. Out-of-range styles draw nothing for that layer.
+void RenderToggle(
+    const SurfaceView& target,
+    const TileRect& clip,
+    std::uint32_t background,
+    const ToggleAtlases* atlases,
+    const ToggleAppearance& appearance);
+
+// Headless entry point behind UIToggle_RenderToBuffer: clamps the styles to the atlas
+// layouts and the knob offset to [-width, width], and renders into width x height BGRA
+// pixels with stride bytes per row. Returns false, writing nothing, for missing atlases or
+// an invalid buffer description.
+bool RenderToggleToBuffer(
+    const ToggleAtlases* atlases,
+    ToggleAppearance appearance,
+    std::uint32_t background,
+    void* pixels,
+    int width,
+    int height,
+    int stride);
+} // namespace ui
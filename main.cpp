@@ -6,6 +6,7 @@
 
 // Function-pointer typedefs for the runtime-loaded DLL API.
 typedef BOOL(*RegisterClassFn)(HINSTANCE);
+typedef BOOL(*PreloadAsyncFn)(void);
 typedef UIToggleHandle(*CreateFn)(const UIToggleCreateParams*);
 typedef void(*DestroyFn)(UIToggleHandle);
 typedef BOOL(*SetCheckedFn)(UIToggleHandle, BOOL, BOOL);
@@ -17,6 +18,7 @@ struct ToggleApi
 {
     HMODULE module = nullptr;
     RegisterClassFn registerClass = nullptr;
+    PreloadAsyncFn preloadAsync = nullptr;
     CreateFn create = nullptr;
     DestroyFn destroy = nullptr;
     SetCheckedFn setChecked = nullptr;
@@ -38,6 +40,7 @@ bool LoadToggleApi(ToggleApi* api)
     }
 
     api->registerClass = reinterpret_cast<RegisterClassFn>(GetProcAddress(api->module, "UIToggle_RegisterClass"));
+    api->preloadAsync = reinterpret_cast<PreloadAsyncFn>(GetProcAddress(api->module, "UIToggle_PreloadAsync"));
     api->create = reinterpret_cast<CreateFn>(GetProcAddress(api->module, "UIToggle_Create"));
     api->destroy = reinterpret_cast<DestroyFn>(GetProcAddress(api->module, "UIToggle_Destroy"));
     api->setChecked = reinterpret_cast<SetCheckedFn>(GetProcAddress(api->module, "UIToggle_SetChecked"));
@@ -118,6 +121,12 @@ int WINAPI WinMain(HINSTANCE instance, HINSTANCE, LPSTR, int show)
         return 1;
     }
 
+    // Optional: start decoding the atlases while the host window is being created.
+    if (g_api.preloadAsync != nullptr)
+    {
+        g_api.preloadAsync();
+    }
+
     if (!g_api.registerClass(instance))
     {
         MessageBoxW(nullptr, L"Failed to register toggle class", L"Error", MB_ICONERROR);
@@ -0,0 +1,385 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AnimationScheduler.h"
+#include "../lib/UI/src/AnimationKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr std::uint64_t kTickMicroseconds = 10000;
+constexpr std::uint64_t kDurationMicroseconds = 250000;
+constexpr int kTravel = 105;
+
+constexpr std::uint64_t kSpringSettleMicroseconds = 300000;
+constexpr std::size_t kKernelLanes = 37; // a few SIMD blocks and a scalar tail
+
+const ui::AnimationCurve kLinear{ui::Easing::Linear, kDurationMicroseconds};
+const ui::SpringParams kSpring{ui::SpringFrequencyForSettleTime(kSpringSettleMicroseconds), 0.25f};
+
+const ui::PixelKernel kSimdKernels[] = {ui::PixelKernel::Sse2, ui::PixelKernel::Avx2, ui::PixelKernel::Neon};
+
+void Expect(bool condition, const char* what)
+{
+    test::Expect(condition, std::string("animation scheduler: ") + what);
+}
+
+// A scheduler on a virtual clock that only moves when the test advances it, counting how
+// often the host is asked to start and stop its timer.
+struct VirtualHost
+{
+    std::uint64_t now = 0;
+    int starts = 0;
+    int stops = 0;
+    ui::AnimationScheduler scheduler{[this]() { return now; }, [this](bool ticking) { ++(ticking ? starts : stops); }};
+
+    const std::vector<ui::AnimationUpdate>& Tick(std::uint64_t interval = kTickMicroseconds)
+    {
+        now += interval;
+        return scheduler.Tick();
+    }
+};
+
+struct RunResult
+{
+    std::uint64_t took;   // virtual time until the scheduler went idle
+    bool endedOnArrival;  // the last tick was the one that put the value on its target
+};
+
+// Runs one animation to its end with ticks spaced by the given intervals, cycling through
+// them. offset follows the updates.
+RunResult RunToEnd(VirtualHost& host, int& offset, const std::vector<std::uint64_t>& intervals)
+{
+    const std::uint64_t start = host.now;
+    bool arrived = false;
+    for (std::size_t i = 0; host.scheduler.IsTicking(); ++i)
+    {
+        arrived = false;
+        for (const ui::AnimationUpdate& update : host.Tick(intervals[i % intervals.size()]))
+        {
+            Expect(update.previous == offset, "an update did not start where the last one ended");
+            offset = update.current;
+            arrived = update.settled;
+        }
+        Expect(i < 100000, "an animation never settled");
+    }
+    return RunResult{host.now - start, arrived};
+}
+} // namespace
+
+// Animations start the shared timer once, advance together, reverse mid-flight from where
+// they are, and stop the timer once when the last one settles or is cancelled.
+void TestAnimationScheduler()
+{
+    VirtualHost host;
+    int a = 0;
+    int b = 0;
+
+    host.scheduler.Animate(&a, 0, 0, kLinear);
+    Expect(!host.scheduler.IsTicking() && host.starts == 0, "an animation with nowhere to go was scheduled");
+
+    host.scheduler.Animate(&a, 0, kTravel, kLinear);
+    host.scheduler.Animate(&b, kTravel, 0, kLinear);
+    Expect(host.starts == 1 && host.scheduler.ActiveCount() == 2, "the timer did not start exactly once");
+
+    // 105 px in 250 ms: 4.2 px per 10 ms tick.
+    const std::vector<ui::AnimationUpdate>& first = host.Tick();
+    Expect(first.size() == 2, "a tick did not advance every animation");
+    for (const ui::AnimationUpdate& update : first)
+    {
+        const int expected = update.owner == &a ? 4 : kTravel - 4;
+        Expect(update.current == expected && !update.settled, "a tick moved the wrong distance");
+        *static_cast<int*>(update.owner) = update.current;
+    }
+
+    // Reverse b mid-flight: it heads back from where it is now.
+    host.scheduler.Animate(&b, b, kTravel, kLinear);
+    int ticks = 1;
+    while (host.scheduler.IsTicking())
+    {
+        for (const ui::AnimationUpdate& update : host.Tick())
+        {
+            *static_cast<int*>(update.owner) = update.current;
+            Expect(!update.settled || update.current == kTravel, "an animation settled off its target");
+        }
+        ++ticks;
+        Expect(ticks < 1000, "animations never settled");
+    }
+    Expect(a == kTravel && b == kTravel, "animations did not end on their targets");
+    Expect(host.stops == 1, "the timer did not stop exactly once");
+    Expect(host.Tick().empty(), "an idle scheduler produced updates");
+
+    host.scheduler.Animate(&a, kTravel, 0, kLinear);
+    host.scheduler.Cancel(&a);
+    Expect(!host.scheduler.IsTicking() && host.stops == 2, "cancelling the last animation did not stop the timer");
+}
+
+// Curve shapes, and that timing depends on the clock alone: jittery or missed ticks skip
+// ahead to where the curve is and end on time instead of stretching the animation.
+// Animations stop as soon as their position can no longer change.
+void TestAnimationCurves()
+{
+    for (const ui::Easing easing : {ui::Easing::Linear, ui::Easing::Cubic, ui::Easing::Spring})
+    {
+        Expect(ui::EaseProgress(easing, 0.0) == 0.0 && ui::EaseProgress(easing, 1.0) == 1.0, "a curve does not run from 0 to 1");
+    }
+    Expect(ui::EaseProgress(ui::Easing::Linear, 0.25) == 0.25, "linear is not linear");
+    Expect(ui::EaseProgress(ui::Easing::Cubic, 0.5) == 0.5 && ui::EaseProgress(ui::Easing::Cubic, 0.1) < 0.01 &&
+        ui::EaseProgress(ui::Easing::Cubic, 0.9) > 0.99, "cubic does not ease in and out");
+    const double peak = ui::EaseProgress(ui::Easing::Spring, 1.0 / 3.0);
+    Expect(peak > 1.1 && peak < 1.2 && std::abs(ui::EaseProgress(ui::Easing::Spring, 0.999) - 1.0) < 0.005, "spring does not overshoot and settle");
+
+    const std::vector<std::vector<std::uint64_t>> tickings = {
+        {kTickMicroseconds},
+        {3000, 17000, 9000, 41000, 10000}, // jitter and a late tick
+        {kTickMicroseconds * 12},          // a UI thread busy for 120 ms at a time
+    };
+    for (const ui::Easing easing : {ui::Easing::Linear, ui::Easing::Cubic, ui::Easing::Spring})
+    {
+        for (const std::vector<std::uint64_t>& intervals : tickings)
+        {
+            VirtualHost host;
+            int offset = 0;
+            host.scheduler.Animate(&offset, 0, kTravel, ui::AnimationCurve{easing, kDurationMicroseconds});
+            const RunResult run = RunToEnd(host, offset, intervals);
+            const std::uint64_t longest = *std::max_element(intervals.begin(), intervals.end());
+            Expect(offset == kTravel, "an animation did not end on its target");
+            Expect(run.took < kDurationMicroseconds + longest, "late ticks stretched an animation");
+            // Monotone curves stop on the tick that reaches the target, not one tick later.
+            Expect(easing == ui::Easing::Spring || run.endedOnArrival, "a knob on its target kept the timer running");
+        }
+    }
+
+    // Halfway through the duration a linear knob is halfway, however the ticks before fell,
+    // and a second tick at the same time moves nothing.
+    VirtualHost host;
+    int offset = 0;
+    host.scheduler.Animate(&offset, 0, kTravel, kLinear);
+    host.Tick(kDurationMicroseconds / 10);
+    const std::vector<ui::AnimationUpdate>& half = host.Tick(kDurationMicroseconds / 2 - kDurationMicroseconds / 10);
+    Expect(half.size() == 1 && half[0].current == (kTravel + 1) / 2, "position does not follow the clock");
+    Expect(host.Tick(0).empty(), "a tick at the same time moved the knob");
+}
+
+// Every SIMD kernel reports the same positions and flags as the scalar one, for lanes that
+// are starting, mid-flight, exactly halfway, negative, settled and of zero duration.
+void TestAnimationKernels()
+{
+    std::vector<float> starts(kKernelLanes);
+    std::vector<float> durations(kKernelLanes);
+    std::vector<std::int32_t> froms(kKernelLanes);
+    std::vector<float> distances(kKernelLanes);
+    std::vector<std::int32_t> positions(kKernelLanes);
+    for (std::size_t i = 0; i < kKernelLanes; ++i)
+    {
+        starts[i] = static_cast<float>(i * 7919 % 300000);
+        durations[i] = i % 11 == 0 ? 0.0f : static_cast<float>(250000 - i % 3 * 50000);
+        froms[i] = static_cast<std::int32_t>(i % 3) * kTravel;
+        distances[i] = static_cast<float>((i % 2 == 0 ? 1 : -1) * static_cast<int>(i % 7 + 1) * 15);
+        positions[i] = froms[i] + static_cast<std::int32_t>(i % 4);
+    }
+    // Halfway at 300000: 105 * 0.5 lands on .5 for linear and cubic.
+    starts[1] = 175000.0f;
+    durations[1] = 250000.0f;
+    distances[1] = static_cast<float>(kTravel);
+    for (const ui::Easing easing : {ui::Easing::Linear, ui::Easing::Cubic, ui::Easing::Spring})
+    {
+        std::vector<std::int32_t> expectedNext(kKernelLanes);
+        std::vector<std::uint8_t> expectedFlags(kKernelLanes);
+        ui::EvaluateCurves(ui::PixelKernel::Scalar, easing, 300000.0f,
+            ui::CurveBatch{starts.data(), durations.data(), froms.data(), distances.data(), positions.data(), expectedNext.data(),
+                expectedFlags.data(), kKernelLanes});
+        Expect(easing == ui::Easing::Spring || expectedNext[1] == froms[1] + (kTravel + 1) / 2,
+            "a lane halfway through did not round half away from zero");
+        for (const ui::PixelKernel kernel : kSimdKernels)
+        {
+            if (!ui::IsPixelKernelSupported(kernel))
+            {
+                continue;
+            }
+            std::vector<std::int32_t> next(kKernelLanes);
+            std::vector<std::uint8_t> flags(kKernelLanes);
+            ui::EvaluateCurves(kernel, easing, 300000.0f,
+                ui::CurveBatch{starts.data(), durations.data(), froms.data(), distances.data(), positions.data(), next.data(), flags.data(),
+                    kKernelLanes});
+            Expect(next == expectedNext && flags == expectedFlags, "a SIMD curve kernel differs from the scalar one");
+        }
+    }
+
+    std::vector<float> offsets(kKernelLanes);
+    std::vector<float> velocities(kKernelLanes);
+    std::vector<float> omegas(kKernelLanes);
+    std::vector<float> steps(kKernelLanes);
+    std::vector<float> decays(kKernelLanes);
+    std::vector<float> rests(kKernelLanes, 0.5f);
+    std::vector<std::int32_t> targets(kKernelLanes);
+    for (std::size_t i = 0; i < kKernelLanes; ++i)
+    {
+        offsets[i] = i % 9 == 0 ? 0.1f : static_cast<float>(static_cast<int>(i * 37 % 211) - 105);
+        velocities[i] = i % 9 == 0 ? 0.0f : static_cast<float>(static_cast<int>(i * 53 % 1601) - 800);
+        omegas[i] = 10.0f + static_cast<float>(i % 5) * 7.0f;
+        steps[i] = 0.001f * static_cast<float>(1 + i % 40);
+        decays[i] = std::exp(-omegas[i] * steps[i]);
+        targets[i] = static_cast<std::int32_t>(i % 2) * kTravel;
+    }
+    std::vector<float> expectedOffsets = offsets;
+    std::vector<float> expectedVelocities = velocities;
+    std::vector<std::int32_t> expectedNext(kKernelLanes);
+    std::vector<std::uint8_t> expectedFlags(kKernelLanes);
+    ui::StepSprings(ui::PixelKernel::Scalar,
+        ui::SpringBatch{expectedOffsets.data(), expectedVelocities.data(), omegas.data(), steps.data(), decays.data(), rests.data(),
+            targets.data(), positions.data(), expectedNext.data(), expectedFlags.data(), kKernelLanes});
+    Expect((expectedFlags[0] & ui::kLaneSettled) != 0 && expectedNext[0] == targets[0], "a spring at rest did not settle");
+    for (const ui::PixelKernel kernel : kSimdKernels)
+    {
+        if (!ui::IsPixelKernelSupported(kernel))
+        {
+            continue;
+        }
+        std::vector<float> actualOffsets = offsets;
+        std::vector<float> actualVelocities = velocities;
+        std::vector<std::int32_t> next(kKernelLanes);
+        std::vector<std::uint8_t> flags(kKernelLanes);
+        ui::StepSprings(kernel, ui::SpringBatch{actualOffsets.data(), actualVelocities.data(), omegas.data(), steps.data(), decays.data(),
+                                    rests.data(), targets.data(), positions.data(), next.data(), flags.data(), kKernelLanes});
+        for (std::size_t i = 0; i < kKernelLanes; ++i)
+        {
+            Expect(std::abs(actualOffsets[i] - expectedOffsets[i]) <= 1e-4f * (1.0f + std::abs(expectedOffsets[i])) &&
+                    std::abs(actualVelocities[i] - expectedVelocities[i]) <= 1e-4f * (1.0f + std::abs(expectedVelocities[i])),
+                "a SIMD spring step differs from the scalar one");
+        }
+        Expect(next == expectedNext && flags == expectedFlags, "a SIMD spring kernel reports differently from the scalar one");
+    }
+}
+
+// A spring released from rest closes on its target without overshoot and settles in about
+// its settle time whatever the ticks, and a retarget mid-flight keeps the velocity instead of
+// reversing on the spot.
+void TestAnimationSprings()
+{
+    const std::vector<std::vector<std::uint64_t>> tickings = {{kTickMicroseconds}, {3000, 17000, 9000, 41000, 10000}};
+    std::uint64_t settleTimes[2] = {};
+    for (std::size_t t = 0; t < tickings.size(); ++t)
+    {
+        VirtualHost host;
+        int offset = 0;
+        host.scheduler.AnimateSpring(&offset, 0, kTravel, kSpring);
+        int previous = 0;
+        std::size_t i = 0;
+        while (host.scheduler.IsTicking())
+        {
+            for (const ui::AnimationUpdate& update : host.Tick(tickings[t][i++ % tickings[t].size()]))
+            {
+                offset = update.current;
+            }
+            Expect(offset >= previous && offset <= kTravel, "a spring released from rest overshot");
+            previous = offset;
+            Expect(i < 10000, "a spring never came to rest");
+        }
+        Expect(offset == kTravel, "a spring did not settle on its target");
+        settleTimes[t] = host.now;
+    }
+    Expect(settleTimes[0] > kSpringSettleMicroseconds / 2 && settleTimes[0] < kSpringSettleMicroseconds * 3 / 2,
+        "a spring settled far from its settle time");
+    Expect(settleTimes[1] + 41000 > settleTimes[0] && settleTimes[1] < settleTimes[0] + 41000, "tick spacing changed when a spring settled");
+
+    // Click on, then off again 60 ms later while the knob is moving fast.
+    VirtualHost host;
+    int offset = 0;
+    host.scheduler.AnimateSpring(&offset, 0, kTravel, kSpring);
+    for (int i = 0; i < 6; ++i)
+    {
+        for (const ui::AnimationUpdate& update : host.Tick())
+        {
+            offset = update.current;
+        }
+    }
+    const int turnedAt = offset;
+    host.scheduler.AnimateSpring(&offset, offset, 0, kSpring);
+    const std::vector<ui::AnimationUpdate>& carried = host.Tick();
+    Expect(carried.size() == 1 && carried[0].current > turnedAt, "a retarget did not carry the knob's velocity");
+    offset = carried[0].current;
+    while (host.scheduler.IsTicking())
+    {
+        for (const ui::AnimationUpdate& update : host.Tick())
+        {
+            offset = update.current;
+        }
+    }
+    Expect(offset == 0 && host.starts == 1 && host.stops == 1, "a retargeted spring did not settle once on its new target");
+
+    // A coarser rest threshold stops sooner.
+    std::uint64_t coarseSettle = 0;
+    {
+        VirtualHost coarse;
+        int value = 0;
+        coarse.scheduler.AnimateSpring(&value, 0, kTravel, ui::SpringParams{kSpring.angularFrequency, 4.0f});
+        while (coarse.scheduler.IsTicking())
+        {
+            coarse.Tick();
+        }
+        coarseSettle = coarse.now;
+    }
+    Expect(coarseSettle < settleTimes[0], "the rest threshold did not end the spring sooner");
+
+    // Switching between a curve and a spring keeps one animation per owner.
+    host.scheduler.AnimateSpring(&offset, 0, kTravel, kSpring);
+    host.scheduler.Animate(&offset, 0, kTravel, kLinear);
+    Expect(host.scheduler.ActiveCount() == 1, "an owner ran a curve and a spring at once");
+    host.scheduler.Cancel(&offset);
+    Expect(!host.scheduler.IsTicking() && host.starts == 2 && host.stops == 2, "cancelling a mixed owner did not stop the timer");
+}
+
+// A flip of each kind of animation settles exactly once, stops the timer, and lets time pass
+// without another wakeup.
+void TestAnimationSettle()
+{
+    const ui::Easing easings[] = {ui::Easing::Linear, ui::Easing::Cubic, ui::Easing::Spring};
+    for (std::size_t kind = 0; kind <= 3; ++kind)
+    {
+        VirtualHost host;
+        int offset = 0;
+        if (kind == 3)
+        {
+            host.scheduler.AnimateSpring(&offset, 0, kTravel, kSpring);
+        }
+        else
+        {
+            host.scheduler.Animate(&offset, 0, kTravel, ui::AnimationCurve{easings[kind], kDurationMicroseconds});
+        }
+        RunToEnd(host, offset, {kTickMicroseconds});
+        const ui::AnimationStats stats = host.scheduler.Stats();
+        Expect(offset == kTravel && stats.settled == 1 && host.stops == 1, "a flip did not settle exactly once");
+
+        host.now += 10000000;
+        Expect(!host.scheduler.IsTicking() && host.starts == 1 && host.scheduler.Stats().ticks == stats.ticks, "a settled scheduler woke up");
+    }
+}
+
+// A bulk "select all" drives every control to its target through the one shared timer.
+void TestAnimationBulk()
+{
+    VirtualHost host;
+    std::vector<int> offsets(500, 0);
+    for (int& offset : offsets)
+    {
+        host.scheduler.Animate(&offset, 0, kTravel, kLinear);
+    }
+    while (host.scheduler.IsTicking())
+    {
+        for (const ui::AnimationUpdate& update : host.Tick())
+        {
+            *static_cast<int*>(update.owner) = update.current;
+        }
+        Expect(host.now < kDurationMicroseconds * 2, "bulk animations never settled");
+    }
+    for (const int offset : offsets)
+    {
+        Expect(offset == kTravel, "a bulk animation did not settle on its target");
+    }
+    Expect(host.starts == 1 && host.stops == 1, "bulk animations did not share one timer");
+}
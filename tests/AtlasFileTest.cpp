@@ -0,0 +1,98 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/AtlasPacker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+bool SameRects(const ui::TileRect* lhs, const std::vector<ui::TileRect>& rhs)
+{
+    return std::memcmp(lhs, rhs.data(), rhs.size() * sizeof(ui::TileRect)) == 0;
+}
+
+void CopyAsset(const char* fileName, const std::string& path)
+{
+    std::FILE* file = std::fopen((fixtures::AssetDirectory() + "/" + fileName).c_str(), "rb");
+    if (file == nullptr)
+    {
+        throw std::runtime_error(std::string("Failed to open asset ") + fileName);
+    }
+    std::vector<unsigned char> bytes;
+    unsigned char buffer[4096];
+    for (std::size_t read = std::fread(buffer, 1, sizeof(buffer), file); read > 0; read = std::fread(buffer, 1, sizeof(buffer), file))
+    {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    std::fclose(file);
+    ui::WriteAtlasFile(path, bytes);
+}
+
+std::vector<unsigned char> Serialize(const fixtures::DecodedAtlas& reference, const ui::PackedAtlas& packed, int columns, int rows,
+    const std::vector<ui::TileRect>& tiles)
+{
+    return ui::SerializeAtlasFile(reference.width, reference.height, columns, rows, tiles, reference.visibleBounds, packed.width,
+        packed.height, packed.packedBounds, packed.pixels.data());
+}
+} // namespace
+
+// A baked .tglatlas maps back to the tables and packed pixels it was written from.
+void TestAtlasFileRoundTrip()
+{
+    const fixtures::DecodedAtlas reference = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const ui::PackedAtlas packed = ui::PackVisibleTiles(reference.pixels.data(), reference.width, reference.visibleBounds);
+    const std::string bakedPath = fixtures::TempFilePath("round-trip.tglatlas");
+    ui::WriteAtlasFile(bakedPath, Serialize(reference, packed, 5, 2, reference.tiles));
+
+    bool roundTrips = false;
+    {
+        const ui::MappedFile file(bakedPath);
+        const ui::AtlasFileView view = ui::ParseAtlasFile(file.data(), file.size());
+        roundTrips = view.sourceWidth == reference.width && view.sourceHeight == reference.height &&
+            view.width == packed.width && view.height == packed.height &&
+            view.tileCount == static_cast<int>(reference.tiles.size()) &&
+            SameRects(view.tiles, reference.tiles) && SameRects(view.visibleBounds, reference.visibleBounds) &&
+            SameRects(view.packedBounds, packed.packedBounds) &&
+            std::memcmp(view.pixels, packed.pixels.data(), packed.pixels.size()) == 0;
+    }
+    std::remove(bakedPath.c_str());
+    test::Expect(roundTrips, "baked atlas does not round-trip");
+}
+
+// Files with a valid checksum but a different grid, or tile rectangles whose ends overflow an
+// int, are rejected; a rejected baked file next to its PNG falls back to decoding the PNG.
+void TestAtlasFileRejects()
+{
+    const fixtures::DecodedAtlas reference = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const ui::PackedAtlas packed = ui::PackVisibleTiles(reference.pixels.data(), reference.width, reference.visibleBounds);
+
+    const std::vector<unsigned char> transposed = Serialize(reference, packed, 2, 5, reference.tiles);
+    test::Expect(test::Throws([&]() { ui::LoadAtlasFromBakedImage(transposed.data(), transposed.size(), ui::kBodyAtlasLayout); }),
+        "baked atlas with a 2x5 grid accepted for a 5x2 layout");
+
+    std::vector<ui::TileRect> overflowing = reference.tiles;
+    overflowing[0] = ui::TileRect{std::numeric_limits<int>::max() - 8, 0, 64, 1};
+    const std::vector<unsigned char> hostile = Serialize(reference, packed, 5, 2, overflowing);
+    test::Expect(test::Throws([&]() { ui::ParseAtlasFile(hostile.data(), hostile.size()); }),
+        "baked atlas with an overflowing tile accepted");
+
+    const std::string bakedPath = fixtures::TempFilePath("switch-body.tglatlas");
+    const std::string pngPath = fixtures::TempFilePath("switch-body.png");
+    ui::WriteAtlasFile(bakedPath, transposed);
+    CopyAsset("switch-body.png", pngPath);
+    std::string directory = fixtures::TempFilePath("");
+    directory.pop_back();
+    const ui::ImageAtlas atlas = ui::LoadAtlasFromDirectory(directory, ui::kBodyAtlasLayout);
+    std::remove(bakedPath.c_str());
+    std::remove(pngPath.c_str());
+    test::Expect(atlas.mapping.data() == nullptr && atlas.tiles.size() == reference.tiles.size() &&
+            SameRects(atlas.tiles.data(), reference.tiles) && SameRects(atlas.visibleBounds.data(), reference.visibleBounds),
+        "rejected baked atlas did not fall back to the PNG");
+}
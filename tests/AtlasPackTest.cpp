@@ -0,0 +1,44 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasPacker.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+bool Overlap(const ui::TileRect& a, const ui::TileRect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+} // namespace
+
+// Every visible part lands inside the packed image, apart from the others, with its pixels.
+void TestAtlasPack()
+{
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const fixtures::DecodedAtlas atlas = fixtures::DecodeAtlas(layout);
+        const ui::PackedAtlas packed = ui::PackVisibleTiles(atlas.pixels.data(), atlas.width, atlas.visibleBounds);
+        const std::string prefix = std::string("atlas packing, ") + layout.name + ": ";
+        for (std::size_t i = 0; i < packed.packedBounds.size(); ++i)
+        {
+            const ui::TileRect& from = atlas.visibleBounds[i];
+            const ui::TileRect& to = packed.packedBounds[i];
+            test::Expect(to.width == from.width && to.height == from.height && to.x >= 0 && to.y >= 0 &&
+                    to.x + to.width <= packed.width && to.y + to.height <= packed.height,
+                prefix + "a tile is resized or outside the image");
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                test::Expect(!Overlap(to, packed.packedBounds[j]), prefix + "tiles overlap");
+            }
+            for (int y = 0; y < from.height; ++y)
+            {
+                const unsigned char* expected = atlas.pixels.data() + (static_cast<std::size_t>(from.y + y) * atlas.width + from.x) * 4;
+                const unsigned char* actual = packed.pixels.data() + (static_cast<std::size_t>(to.y + y) * packed.width + to.x) * 4;
+                test::Expect(std::memcmp(expected, actual, static_cast<std::size_t>(from.width) * 4) == 0, prefix + "tile pixels differ");
+            }
+        }
+    }
+}
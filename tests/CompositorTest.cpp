@@ -0,0 +1,162 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/Compositor.h"
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+const ui::PixelKernel kKernels[] = {ui::PixelKernel::Scalar, ui::PixelKernel::Sse2, ui::PixelKernel::Avx2, ui::PixelKernel::Neon};
+
+// The two SrcOver layers of a golden frame, blended over frame through one kernel.
+void CompositeScene(ui::PixelKernel kernel, const fixtures::SceneTiles& tiles, const ui::SurfaceView& frame, const ui::TileRect& clip)
+{
+    const ui::TileRect bodySource{0, 0, tiles.bodyRect.width, tiles.bodyRect.height};
+    const ui::ImageView bodyImage{tiles.body.data(), bodySource.width, bodySource.height, bodySource.width * 4};
+    ui::CompositeSrcOver(kernel, frame, tiles.bodyRect, bodyImage, bodySource, clip);
+
+    const ui::TileRect knobSource{0, 0, tiles.knobRect.width, tiles.knobRect.height};
+    const ui::ImageView knobImage{tiles.knob.data(), knobSource.width, knobSource.height, knobSource.width * 4};
+    ui::CompositeSrcOver(kernel, frame, tiles.knobRect, knobImage, knobSource, clip);
+}
+
+// Composes a golden frame layer by layer through one kernel. The headless render test checks
+// the shared ui::RenderToggle path against the same checksums.
+std::vector<unsigned char> RenderScene(ui::PixelKernel kernel, const fixtures::GoldenScene& scene, const fixtures::SceneTiles& tiles, const ui::TileRect& clip)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(scene.width) * scene.height * 4);
+    const ui::SurfaceView frame{pixels.data(), scene.width, scene.height, scene.width * 4};
+    ui::FillSurface(frame, ui::TileRect{0, 0, scene.width, scene.height}, fixtures::kGoldenBackground);
+    CompositeScene(kernel, tiles, frame, clip);
+    return pixels;
+}
+
+// Every (source alpha, destination value) pair with premultiplied sources, plus transparent
+// and opaque runs long enough to hit the vector fast paths and an odd tail.
+void BuildBlendInputs(std::vector<unsigned char>& src, std::vector<unsigned char>& dst)
+{
+    for (int alpha = 0; alpha < 256; ++alpha)
+    {
+        for (int value = 0; value < 256; ++value)
+        {
+            const unsigned char color = static_cast<unsigned char>((value * 7 + alpha) % (alpha + 1));
+            const unsigned char s[4] = {color, static_cast<unsigned char>(alpha - color), static_cast<unsigned char>(alpha / 2), static_cast<unsigned char>(alpha)};
+            const unsigned char d[4] = {static_cast<unsigned char>(value), static_cast<unsigned char>(255 - value), static_cast<unsigned char>(value ^ 0xA5), static_cast<unsigned char>(value | 0x80)};
+            src.insert(src.end(), s, s + 4);
+            dst.insert(dst.end(), d, d + 4);
+        }
+    }
+    for (int i = 0; i < 19; ++i)
+    {
+        const unsigned char transparent[4] = {0, 0, 0, 0};
+        const unsigned char opaque[4] = {10, 20, 30, 255};
+        const unsigned char background[4] = {200, 100, 50, 255};
+        src.insert(src.end(), transparent, transparent + 4);
+        dst.insert(dst.end(), background, background + 4);
+        src.insert(src.end(), opaque, opaque + 4);
+        dst.insert(dst.end(), background, background + 4);
+    }
+    const unsigned char tail[4] = {1, 2, 3, 9};
+    src.insert(src.end(), tail, tail + 4);
+    dst.insert(dst.end(), tail, tail + 4);
+}
+
+// The scalar kernel against the blend equation evaluated directly: round-half-up of
+// src + dst * (255 - a) / 255 (255 is odd, so exact halves never occur).
+void VerifyScalarAgainstEquation(const std::vector<unsigned char>& src, const std::vector<unsigned char>& dst)
+{
+    std::vector<unsigned char> blended = dst;
+    ui::BlendSrcOver(ui::PixelKernel::Scalar, src.data(), blended.data(), src.size() / 4);
+    for (std::size_t i = 0; i < src.size(); ++i)
+    {
+        const unsigned inverse = 255u - src[(i & ~std::size_t(3)) + 3];
+        const unsigned expected = src[i] + (2 * dst[i] * inverse + 255) / 510;
+        test::Expect(blended[i] == (expected > 255 ? 255 : expected), "scalar SrcOver does not match the blend equation");
+    }
+}
+
+void VerifyBlendAgainstScalar(ui::PixelKernel kernel, const std::vector<unsigned char>& src, const std::vector<unsigned char>& dst)
+{
+    std::vector<unsigned char> expected = dst;
+    std::vector<unsigned char> actual = dst;
+    ui::BlendSrcOver(ui::PixelKernel::Scalar, src.data(), expected.data(), src.size() / 4);
+    ui::BlendSrcOver(kernel, src.data(), actual.data(), src.size() / 4);
+    test::Expect(actual == expected, std::string("SrcOver kernel mismatch: ") + ui::PixelKernelName(kernel));
+}
+} // namespace
+
+// The scalar SrcOver kernel against the blend equation.
+void TestBlendEquation()
+{
+    std::vector<unsigned char> src;
+    std::vector<unsigned char> dst;
+    BuildBlendInputs(src, dst);
+    VerifyScalarAgainstEquation(src, dst);
+}
+
+// Every supported SrcOver kernel bit-for-bit against the scalar one.
+void TestBlendKernels()
+{
+    std::vector<unsigned char> src;
+    std::vector<unsigned char> dst;
+    BuildBlendInputs(src, dst);
+    for (ui::PixelKernel kernel : kKernels)
+    {
+        if (ui::IsPixelKernelSupported(kernel))
+        {
+            VerifyBlendAgainstScalar(kernel, src, dst);
+        }
+    }
+}
+
+// Every golden frame matches its checksum on every kernel, and a clipped redraw reproduces
+// the full frame inside the clip and leaves the background outside it.
+void TestGoldenFrames()
+{
+    const fixtures::DecodedAtlas body = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const fixtures::DecodedAtlas knob = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+
+    for (const fixtures::GoldenScene& scene : fixtures::GoldenScenes())
+    {
+        const ui::TileRect bounds{0, 0, scene.width, scene.height};
+        const fixtures::SceneTiles tiles = fixtures::ScaleSceneTiles(scene, body, knob);
+        const std::vector<unsigned char> reference = RenderScene(ui::PixelKernel::Scalar, scene, tiles, bounds);
+        const std::uint32_t checksum = ui::ComputeAtlasChecksum(reference.data(), reference.size());
+        if (checksum != scene.checksum)
+        {
+            std::printf("%s: checksum 0x%08X, golden 0x%08X\n", scene.name, checksum, scene.checksum);
+        }
+        test::Expect(checksum == scene.checksum, std::string("golden frame mismatch: ") + scene.name);
+
+        // A clipped redraw over the full frame must reproduce it exactly.
+        const ui::TileRect clip{scene.width / 3, scene.height / 4, scene.width / 3 + 1, scene.height / 2};
+        std::vector<unsigned char> clipped = RenderScene(ui::PixelKernel::Scalar, scene, tiles, clip);
+        for (int y = 0; y < scene.height; ++y)
+        {
+            for (int x = 0; x < scene.width; ++x)
+            {
+                const bool inside = x >= clip.x && x < clip.x + clip.width && y >= clip.y && y < clip.y + clip.height;
+                const std::size_t offset = (static_cast<std::size_t>(y) * scene.width + x) * 4;
+                for (int c = 0; c < 4; ++c)
+                {
+                    const unsigned char expected = inside ? reference[offset + c] : static_cast<unsigned char>(fixtures::kGoldenBackground >> (c * 8));
+                    test::Expect(clipped[offset + c] == expected, std::string("clipped composite differs: ") + scene.name);
+                }
+            }
+        }
+
+        for (ui::PixelKernel kernel : kKernels)
+        {
+            if (ui::IsPixelKernelSupported(kernel))
+            {
+                test::Expect(RenderScene(kernel, scene, tiles, bounds) == reference,
+                    std::string("golden frame mismatch for ") + ui::PixelKernelName(kernel) + ": " + scene.name);
+            }
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#include "Test.h"
+
+#include "../lib/UI/include/stb_image.h"
+#include "../lib/UI/src/ImageDecode.h"
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <string>
+#include <vector>
+
+// Decoding straight into the surface and converting in place gives the same pixels as
+// stbi_load into a heap buffer followed by a conversion into the surface.
+void TestDirectDecode()
+{
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const std::string path = fixtures::AssetDirectory() + "/" + layout.name + ".png";
+
+        int width = 0;
+        int height = 0;
+        ui::ReadImageSize(path.c_str(), width, height);
+        const std::size_t imageBytes = static_cast<std::size_t>(width) * height * 4;
+        std::vector<unsigned char> copiedSurface(imageBytes);
+        std::vector<unsigned char> directSurface(imageBytes);
+
+        int decodedWidth = 0;
+        int decodedHeight = 0;
+        int channels = 0;
+        unsigned char* rgba = stbi_load(path.c_str(), &decodedWidth, &decodedHeight, &channels, 4);
+        test::Expect(rgba != nullptr, "failed to load " + path);
+        ui::PremultiplyRgbaToBgraRows(rgba, copiedSurface.data(), width, height);
+        stbi_image_free(rgba);
+
+        test::Expect(ui::DecodeRgbaInto(path.c_str(), directSurface.data(), width, height),
+            std::string("stb_image did not decode into the surface for ") + layout.name);
+        ui::PremultiplyRgbaToBgraRows(directSurface.data(), directSurface.data(), width, height);
+        test::Expect(copiedSurface == directSurface, std::string("direct decode differs for ") + layout.name);
+    }
+}
@@ -0,0 +1,110 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/FrameCache.h"
+#include "../lib/UI/src/ToggleRenderer.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr int kStepPixels = 4; // kAnimationStepPixels in Toggle.cpp
+
+struct SweepResult
+{
+    int frames = 0;
+    long long damagePixels = 0;   // area of every step's invalid rectangle
+    long long composedPixels = 0; // what paint reported rendering
+};
+
+std::unique_ptr<ui::ToggleAtlases> LoadAtlases()
+{
+    return ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+}
+
+// Animates the knob of scene off -> on -> off one step per frame, the way
+// ToggleControl::AnimateStep does: after a full first paint, paint refreshes only the knob sweep
+// of a persistent buffer and returns the pixels it composed. Every frame must match a full
+// render.
+SweepResult Sweep(const ui::ToggleAtlases& atlases,
+    const fixtures::GoldenScene& scene,
+    const std::function<int(const ui::SurfaceView&, const ui::TileRect&, const ui::ToggleAppearance&)>& paint)
+{
+    std::vector<unsigned char> frame(static_cast<std::size_t>(scene.width) * scene.height * 4);
+    std::vector<unsigned char> reference(frame.size());
+    const ui::SurfaceView target{frame.data(), scene.width, scene.height, scene.width * 4};
+    const ui::SurfaceView full{reference.data(), scene.width, scene.height, scene.width * 4};
+    const ui::TileRect bounds{0, 0, scene.width, scene.height};
+    const int travel = ui::KnobTravel(&atlases);
+
+    ui::ToggleAppearance appearance;
+    appearance.bodyStyle = scene.bodyStyle;
+    appearance.switchStyle = scene.switchStyle;
+    paint(target, bounds, appearance);
+
+    SweepResult result;
+    for (int leg = 0; leg < 2; ++leg)
+    {
+        const int targetOffset = leg == 0 ? travel : 0;
+        while (appearance.knobOffset != targetOffset)
+        {
+            const int previous = appearance.knobOffset;
+            appearance.knobOffset = previous < targetOffset ? std::min(previous + kStepPixels, targetOffset)
+                                                            : std::max(previous - kStepPixels, targetOffset);
+
+            const ui::TileRect clip = ui::UnionRects(ui::KnobRect(&atlases, scene.switchStyle, scene.width, scene.height, previous),
+                ui::KnobRect(&atlases, scene.switchStyle, scene.width, scene.height, appearance.knobOffset));
+            result.composedPixels += paint(target, clip, appearance);
+            result.damagePixels += static_cast<long long>(clip.width) * clip.height;
+            ++result.frames;
+
+            std::fill(reference.begin(), reference.end(), 0);
+            ui::RenderToggle(full, bounds, fixtures::kGoldenBackground, &atlases, appearance);
+            test::Expect(ui::ComputeAtlasChecksum(reference.data(), reference.size()) == ui::ComputeAtlasChecksum(frame.data(), frame.size()),
+                "knob sweep repaint differs from a full frame");
+        }
+    }
+    return result;
+}
+} // namespace
+
+// Repainting only the knob sweep reproduces every frame and repaints less than the whole
+// client area per step.
+void TestDirtyRect()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = LoadAtlases();
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    const SweepResult result = Sweep(*atlases, scene, [&](const ui::SurfaceView& target, const ui::TileRect& clip, const ui::ToggleAppearance& appearance) {
+        ui::RenderToggle(target, clip, fixtures::kGoldenBackground, atlases.get(), appearance);
+        return clip.width * clip.height;
+    });
+
+    const long long clientPixels = static_cast<long long>(scene.width) * scene.height;
+    test::Expect(result.damagePixels < clientPixels * result.frames, "knob sweep repaints the whole client area");
+}
+
+// With a cold frame cache each step composes only its invalid rectangle, as WM_PAINT does
+// through PaintFrame, and a second control sweeping the same frames composes nothing.
+void TestDirtyRectColdCache()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = LoadAtlases();
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    // Room for every frame of both legs, so the second sweep finds them all.
+    ui::FrameCache cache(ui::kDefaultFrameCacheBudget * 4);
+    const auto paint = [&](const ui::SurfaceView& target, const ui::TileRect& clip, const ui::ToggleAppearance& appearance) {
+        return ui::PaintFrame(cache, target, clip, *atlases, appearance, fixtures::kGoldenBackground);
+    };
+
+    const SweepResult cold = Sweep(*atlases, scene, paint);
+    // The last step lands on the resting frame the first paint cached, so it composes nothing.
+    test::Expect(cold.composedPixels > 0 && cold.composedPixels <= cold.damagePixels,
+        "a cold-cache sweep composed more than its invalid rectangles");
+    const SweepResult warm = Sweep(*atlases, scene, paint);
+    test::Expect(warm.composedPixels == 0, "a warm-cache sweep composed frames again");
+}
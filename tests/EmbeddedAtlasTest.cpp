@@ -0,0 +1,25 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/EmbeddedAtlases.h"
+
+#include <string>
+#include <vector>
+
+#if defined(UI_TOGGLE_EMBEDDED_ATLASES)
+// The atlases compiled in by UI_TOGGLE_EMBED_ASSETS match a fresh bake of the PNGs.
+void TestEmbeddedAtlases()
+{
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const ui::EmbeddedAtlas* embedded = ui::FindEmbeddedAtlas(layout.name);
+        test::Expect(embedded != nullptr, std::string("atlas not embedded: ") + layout.name);
+
+        const fixtures::RgbaImage image = fixtures::LoadAssetImage((std::string(layout.name) + ".png").c_str());
+        const std::vector<unsigned char> baked = ui::BakeAtlasFile(image.pixels.data(), image.width, image.height, layout);
+        test::Expect(baked == std::vector<unsigned char>(embedded->data, embedded->data + embedded->size),
+            std::string("embedded atlas differs from a fresh bake: ") + layout.name);
+    }
+}
+#endif
@@ -0,0 +1,102 @@
+#include "Fixtures.h"
+
+#include "../lib/UI/src/ImageDecode.h"
+#include "../lib/UI/src/PixelKernels.h"
+#include "../lib/UI/src/Resample.h"
+
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+std::string g_assetDirectory = UI_TOGGLE_ASSET_DIR;
+} // namespace
+
+namespace fixtures
+{
+const std::string& AssetDirectory()
+{
+    return g_assetDirectory;
+}
+
+void SetAssetDirectory(const std::string& directory)
+{
+    g_assetDirectory = directory;
+}
+
+std::string TempFilePath(const char* fileName)
+{
+    const char* directory = std::getenv("TMPDIR");
+    if (directory == nullptr)
+    {
+        directory = std::getenv("TEMP");
+    }
+    return std::string(directory != nullptr ? directory : ".") + "/" + fileName;
+}
+
+RgbaImage LoadAssetImage(const char* fileName)
+{
+    const std::string path = g_assetDirectory + "/" + fileName;
+
+    RgbaImage image;
+    ui::ReadImageSize(path.c_str(), image.width, image.height);
+    image.pixels.resize(static_cast<std::size_t>(image.width) * image.height * 4);
+    ui::DecodeRgbaInto(path.c_str(), image.pixels.data(), image.width, image.height);
+    return image;
+}
+
+DecodedAtlas DecodeAtlas(const ui::AtlasLayout& layout)
+{
+    RgbaImage image = LoadAssetImage((std::string(layout.name) + ".png").c_str());
+
+    DecodedAtlas atlas;
+    atlas.width = image.width;
+    atlas.height = image.height;
+    atlas.pixels = std::move(image.pixels);
+    ui::PremultiplyRgbaToBgraRows(atlas.pixels.data(), atlas.pixels.data(), atlas.width, atlas.height);
+    atlas.tiles = ui::BuildTileGrid(atlas.width, atlas.height, layout.columns, layout.rows);
+    atlas.visibleBounds = ui::ComputeVisibleBoundsTable(atlas.pixels.data(), atlas.width, atlas.tiles);
+    return atlas;
+}
+
+std::vector<unsigned char> ScaleTile(const DecodedAtlas& atlas, int tileIndex, int width, int height)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+    const ui::ImageView source{atlas.pixels.data(), atlas.width, atlas.height, atlas.width * 4};
+    const ui::TileRect& bounds = atlas.visibleBounds[static_cast<std::size_t>(tileIndex)];
+    const std::vector<ui::MipLevel> chain = ui::BuildMipChain(source, bounds);
+    const ui::SurfaceView target{pixels.data(), width, height, width * 4};
+    if (const ui::MipLevel* level = ui::SelectMipLevel(chain, width, height))
+    {
+        ui::ResampleImage(ui::ImageView{level->pixels.data(), level->width, level->height, level->width * 4}, ui::TileRect{0, 0, level->width, level->height}, target);
+    }
+    else
+    {
+        ui::ResampleImage(source, bounds, target);
+    }
+    return pixels;
+}
+
+SceneTiles ScaleSceneTiles(const GoldenScene& scene, const DecodedAtlas& body, const DecodedAtlas& knob)
+{
+    SceneTiles tiles;
+    tiles.bodyRect = ui::TileRect{0, 0, scene.width, scene.height};
+    tiles.knobRect = ui::TileRect{scene.knobOffset, 0, scene.width, scene.height};
+    tiles.body = ScaleTile(body, scene.bodyStyle, scene.width, scene.height);
+    tiles.knob = ScaleTile(knob, scene.switchStyle, scene.width, scene.height);
+    return tiles;
+}
+
+const std::vector<GoldenScene>& GoldenScenes()
+{
+    static const std::vector<GoldenScene> scenes = {
+        {"1:1 off", 315, 125, 0, 0, 0, 0xAB9828F0u},
+        {"1:1 on", 315, 125, 3, 2, 105, 0x89C216DEu},
+        {"2x upscale", 630, 250, 7, 4, 40, 0x2D8E7C1Du},
+        {"downscale", 150, 60, 9, 5, 17, 0x9C400FE5u},
+        {"odd size, knob past edge", 233, 97, 4, 1, 200, 0xD765114Fu},
+        {"small, body from mip level 1", 120, 50, 5, 3, 30, 0xC43860A7u},
+    };
+    return scenes;
+}
+} // namespace fixtures
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../lib/UI/src/Atlas.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Assets, golden frames and reference helpers shared by the UIToggle tests and benchmarks.
+namespace fixtures
+{
+struct RgbaImage
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+// An atlas decoded the way the DLL's PNG path does it: premultiplied BGRA plus tables.
+struct DecodedAtlas
+{
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+    std::vector<ui::TileRect> tiles;
+    std::vector<ui::TileRect> visibleBounds;
+};
+
+// Directory holding the source PNG atlases: lib/UI/assets/Troggle unless a command line
+// overrides it.
+const std::string& AssetDirectory();
+void SetAssetDirectory(const std::string& directory);
+
+// Path for a scratch file in the system temporary directory.
+std::string TempFilePath(const char* fileName);
+
+// Decodes an image from the asset directory as straight RGBA. Throws on failure.
+RgbaImage LoadAssetImage(const char* fileName);
+
+// Decodes <layout.name>.png from the asset directory into a DecodedAtlas. Throws on failure.
+DecodedAtlas DecodeAtlas(const ui::AtlasLayout& layout);
+
+// Resamples tile tileIndex of atlas to width x height from its closest mip level, as
+// ui::RenderToggle does through its tile cache.
+std::vector<unsigned char> ScaleTile(const DecodedAtlas& atlas, int tileIndex, int width, int height);
+
+// A toggle frame in the shape ToggleControl::OnPaint renders it, with the checksum
+// (ui::ComputeAtlasChecksum) of the expected pixels for the assets in lib/UI/assets/Troggle.
+struct GoldenScene
+{
+    const char* name;
+    int width;
+    int height;
+    int bodyStyle;
+    int switchStyle;
+    int knobOffset;
+    std::uint32_t checksum;
+};
+
+// Background every golden frame is rendered over.
+constexpr std::uint32_t kGoldenBackground = 0xFFF0F0F0;
+
+// The golden frames shared by the compositor and headless rendering checks. Update them only
+// for an intentional asset or blend change.
+const std::vector<GoldenScene>& GoldenScenes();
+
+// The body and knob layers of a golden frame: each tile's visible part resampled with
+// ScaleTile to the frame size, and where it goes (the knob shifted by its offset).
+struct SceneTiles
+{
+    std::vector<unsigned char> body;
+    ui::TileRect bodyRect;
+    std::vector<unsigned char> knob;
+    ui::TileRect knobRect;
+};
+
+SceneTiles ScaleSceneTiles(const GoldenScene& scene, const DecodedAtlas& body, const DecodedAtlas& knob);
+} // namespace fixtures
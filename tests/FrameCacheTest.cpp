@@ -0,0 +1,108 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/FrameCache.h"
+
+#include <memory>
+#include <string>
+
+namespace
+{
+ui::ToggleAppearance AppearanceFor(const fixtures::GoldenScene& scene)
+{
+    ui::ToggleAppearance appearance;
+    appearance.bodyStyle = scene.bodyStyle;
+    appearance.switchStyle = scene.switchStyle;
+    appearance.knobOffset = scene.knobOffset;
+    return appearance;
+}
+
+std::unique_ptr<ui::ToggleAtlases> LoadAtlases()
+{
+    return ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+}
+
+void Expect(bool condition, const char* what)
+{
+    test::Expect(condition, std::string("frame cache: ") + what);
+}
+} // namespace
+
+// Cached frames match the golden frames, and a repeated lookup is a hit on the same frame.
+void TestFrameCacheGoldens()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = LoadAtlases();
+    ui::FrameCache cache(ui::kDefaultFrameCacheBudget);
+    for (const fixtures::GoldenScene& scene : fixtures::GoldenScenes())
+    {
+        const ui::ToggleAppearance appearance = AppearanceFor(scene);
+        const auto first = ui::GetComposedFrame(cache, *atlases, appearance, fixtures::kGoldenBackground, scene.width, scene.height);
+        const auto second = ui::GetComposedFrame(cache, *atlases, appearance, fixtures::kGoldenBackground, scene.width, scene.height);
+        Expect(first == second, "a repeated lookup composed the frame again");
+        Expect(ui::ComputeAtlasChecksum(first->pixels.data(), first->pixels.size()) == scene.checksum, "cached frame does not match the golden frame");
+    }
+    const std::size_t sceneCount = fixtures::GoldenScenes().size();
+    const ui::CacheStats stats = cache.Stats();
+    Expect(stats.hits == sceneCount && stats.misses == sceneCount && stats.entries == sceneCount, "unexpected hit/miss counts");
+}
+
+// Frames beyond the byte budget evict the least recently used one.
+void TestFrameCacheEviction()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = LoadAtlases();
+
+    // Room for two 315x125 frames: the least recently used one goes when a third arrives.
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    const std::size_t frameBytes = static_cast<std::size_t>(scene.width) * scene.height * 4;
+    ui::FrameCache small(frameBytes * 2);
+    ui::ToggleAppearance a = AppearanceFor(scene);
+    ui::ToggleAppearance b = a;
+    ui::ToggleAppearance c = a;
+    b.knobOffset += 4;
+    c.knobOffset += 8;
+    const auto get = [&](const ui::ToggleAppearance& appearance) {
+        return ui::GetComposedFrame(small, *atlases, appearance, fixtures::kGoldenBackground, scene.width, scene.height);
+    };
+    get(a);
+    get(b);
+    get(a);
+    get(c);
+    const ui::CacheStats stats = small.Stats();
+    Expect(stats.entries == 2 && stats.bytesUsed == frameBytes * 2, "budget not enforced");
+    const std::uint64_t missesBefore = stats.misses;
+    get(a);
+    get(c);
+    Expect(small.Stats().misses == missesBefore, "recently used frames were evicted");
+    get(b);
+    Expect(small.Stats().misses == missesBefore + 1, "least recently used frame was kept");
+    small.SetByteBudget(0);
+    Expect(small.Stats().entries == 0 && small.Stats().bytesUsed == 0, "a zero budget kept frames");
+}
+
+// A frame the cache cannot hold is left to the caller instead of being composed in full.
+void TestFrameCacheBudget()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = LoadAtlases();
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    const std::size_t frameBytes = static_cast<std::size_t>(scene.width) * scene.height * 4;
+    const ui::ToggleAppearance a = AppearanceFor(scene);
+    ui::FrameCache small(0);
+
+    int composedPixels = -1;
+    Expect(ui::GetComposedFrame(small, *atlases, a, fixtures::kGoldenBackground, scene.width, scene.height, &composedPixels) == nullptr &&
+            composedPixels == 0,
+        "a disabled cache composed a frame");
+    small.SetByteBudget(frameBytes - 1);
+    Expect(ui::GetComposedFrame(small, *atlases, a, fixtures::kGoldenBackground, scene.width, scene.height) == nullptr &&
+            small.Stats().entries == 0,
+        "a frame over the budget was composed");
+    small.SetByteBudget(frameBytes);
+    Expect(ui::GetComposedFrame(small, *atlases, a, fixtures::kGoldenBackground, scene.width, scene.height, &composedPixels) != nullptr &&
+            composedPixels == scene.width * scene.height,
+        "a cacheable frame was not composed in full");
+    ui::GetComposedFrame(small, *atlases, a, fixtures::kGoldenBackground, scene.width, scene.height, &composedPixels);
+    Expect(composedPixels == 0, "a cached frame counted as composed");
+}
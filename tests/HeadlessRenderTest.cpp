@@ -0,0 +1,128 @@
+#include "Test.h"
+
+#include "../lib/UI/include/ToggleRender.h"
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/ToggleRenderer.h"
+
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int kRowPadding = 12;
+constexpr unsigned char kPaddingByte = 0xCD;
+
+UIToggleRenderParams ParamsFor(const fixtures::GoldenScene& scene)
+{
+    UIToggleRenderParams params{};
+    params.body_style = scene.bodyStyle;
+    params.switch_style = scene.switchStyle;
+    params.knob_offset = scene.knobOffset;
+    params.background = fixtures::kGoldenBackground;
+    return params;
+}
+
+// Renders through the public C API into rows padded to a wider stride and checks that the
+// padding is left alone; returns the tightly packed frame.
+std::vector<unsigned char> RenderThroughApi(const fixtures::GoldenScene& scene)
+{
+    const int rowBytes = scene.width * 4;
+    const int stride = rowBytes + kRowPadding;
+    std::vector<unsigned char> padded(static_cast<std::size_t>(stride) * scene.height, kPaddingByte);
+    const UIToggleRenderParams params = ParamsFor(scene);
+    test::Expect(UIToggle_RenderToBuffer(&params, padded.data(), scene.width, scene.height, stride),
+        std::string("UIToggle_RenderToBuffer failed: ") + scene.name);
+
+    std::vector<unsigned char> frame;
+    frame.reserve(static_cast<std::size_t>(rowBytes) * scene.height);
+    for (int y = 0; y < scene.height; ++y)
+    {
+        const unsigned char* row = padded.data() + static_cast<std::size_t>(y) * stride;
+        frame.insert(frame.end(), row, row + rowBytes);
+        for (int i = rowBytes; i < stride; ++i)
+        {
+            test::Expect(row[i] == kPaddingByte, "UIToggle_RenderToBuffer wrote past the row width");
+        }
+    }
+    return frame;
+}
+
+void ExpectGolden(const char* backend, const fixtures::GoldenScene& scene, const std::vector<unsigned char>& frame)
+{
+    const std::uint32_t checksum = ui::ComputeAtlasChecksum(frame.data(), frame.size());
+    if (checksum != scene.checksum)
+    {
+        std::printf("%s, %s: checksum 0x%08X, golden 0x%08X\n", backend, scene.name, checksum, scene.checksum);
+    }
+    test::Expect(checksum == scene.checksum, std::string(backend) + " does not match the golden frame: " + scene.name);
+}
+} // namespace
+
+// The backend-neutral renderer and the headless C API both reproduce the golden frames; the
+// API reports the atlases' knob travel and the tile cache that served the renders.
+void TestHeadlessRender()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+
+    for (const fixtures::GoldenScene& scene : fixtures::GoldenScenes())
+    {
+        std::vector<unsigned char> frame(static_cast<std::size_t>(scene.width) * scene.height * 4);
+        ui::ToggleAppearance appearance;
+        appearance.bodyStyle = scene.bodyStyle;
+        appearance.switchStyle = scene.switchStyle;
+        appearance.knobOffset = scene.knobOffset;
+        const ui::SurfaceView target{frame.data(), scene.width, scene.height, scene.width * 4};
+        ui::RenderToggle(target, ui::TileRect{0, 0, scene.width, scene.height}, fixtures::kGoldenBackground, atlases.get(), appearance);
+        ExpectGolden("ui::RenderToggle", scene, frame);
+
+        ExpectGolden("UIToggle_RenderToBuffer", scene, RenderThroughApi(scene));
+    }
+
+    int travel = 0;
+    test::Expect(UIToggle_GetKnobTravel(&travel) && travel == ui::KnobTravel(atlases.get()),
+        "UIToggle_GetKnobTravel disagrees with the atlases");
+
+    UIToggleCacheStats tileCache{};
+    test::Expect(UIToggle_GetTileCacheStats(&tileCache) && tileCache.misses != 0 && tileCache.entries != 0 &&
+            tileCache.bytes_used <= tileCache.byte_budget,
+        "UIToggle_GetTileCacheStats does not reflect the scaled tiles");
+}
+
+// The headless API rejects null, empty and undersized arguments.
+void TestHeadlessArguments()
+{
+    const UIToggleRenderParams params = ParamsFor(fixtures::GoldenScenes()[0]);
+    unsigned char pixel[4] = {};
+    test::Expect(!UIToggle_RenderToBuffer(nullptr, pixel, 1, 1, 4) && !UIToggle_RenderToBuffer(&params, nullptr, 1, 1, 4) &&
+            !UIToggle_RenderToBuffer(&params, pixel, 0, 1, 4) && !UIToggle_RenderToBuffer(&params, pixel, 1, 1, 3) &&
+            !UIToggle_GetKnobTravel(nullptr),
+        "headless API accepted invalid arguments");
+}
+
+// Knob offsets at the ends of the int range render like an offset just past either edge: the
+// body without a knob, and nothing written outside the buffer.
+void TestHeadlessKnobOffsetLimits()
+{
+    const fixtures::GoldenScene& scene = fixtures::GoldenScenes()[1];
+    fixtures::GoldenScene outside = scene;
+    std::vector<unsigned char> expected;
+    for (const int offset : {scene.width, -scene.width})
+    {
+        outside.knobOffset = offset;
+        const std::vector<unsigned char> past = RenderThroughApi(outside);
+        test::Expect(expected.empty() || past == expected, "a knob past either edge left part of it in the frame");
+        expected = past;
+    }
+
+    for (const int offset : {std::numeric_limits<int>::max(), std::numeric_limits<int>::min(), std::numeric_limits<int>::max() - scene.width})
+    {
+        outside.knobOffset = offset;
+        test::Expect(RenderThroughApi(outside) == expected, "an extreme knob offset did not render as a knob outside the frame");
+    }
+}
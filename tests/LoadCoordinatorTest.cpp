@@ -0,0 +1,94 @@
+#include "Test.h"
+
+#include "../lib/UI/src/LoadCoordinator.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int kThreads = 32;
+constexpr int kRounds = 100;
+constexpr int kPayloadSize = 4096;
+
+// Stands in for the atlas snapshot: readers check that every element was written.
+struct Snapshot
+{
+    std::vector<int> payload;
+};
+
+// The EnsureAtlasesLoaded pattern from Toggle.cpp, on the portable coordinator.
+const Snapshot* EnsureLoaded(ui::LoadCoordinator<Snapshot>& atlases, std::atomic<int>& loads)
+{
+    if (const Snapshot* snapshot = atlases.Get())
+    {
+        return snapshot;
+    }
+
+    if (atlases.TryBegin())
+    {
+        loads.fetch_add(1, std::memory_order_relaxed);
+        std::unique_ptr<Snapshot> snapshot(new Snapshot());
+        snapshot->payload.assign(kPayloadSize, 7);
+        const Snapshot* published = snapshot.get();
+        atlases.Finish(std::move(snapshot));
+        return published;
+    }
+
+    return atlases.WaitWhileLoading();
+}
+} // namespace
+
+// Races many threads through first-use initialization, checking every round that exactly one
+// thread loaded and every thread saw the same, fully written snapshot.
+void TestLoadCoordinator()
+{
+    long long failures = 0;
+    for (int round = 0; round < kRounds; ++round)
+    {
+        ui::LoadCoordinator<Snapshot> atlases;
+        std::atomic<int> loads{0};
+        std::atomic<int> arrived{0};
+        std::atomic<long long> roundFailures{0};
+        std::vector<const Snapshot*> seen(kThreads, nullptr);
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < kThreads; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                // Spin until every thread is ready so they hit the cold path together.
+                arrived.fetch_add(1);
+                while (arrived.load() < kThreads)
+                {
+                    std::this_thread::yield();
+                }
+
+                const Snapshot* snapshot = EnsureLoaded(atlases, loads);
+                seen[static_cast<std::size_t>(t)] = snapshot;
+                if (snapshot == nullptr || snapshot->payload.size() != kPayloadSize || snapshot->payload.back() != 7)
+                {
+                    roundFailures.fetch_add(1);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const Snapshot* snapshot : seen)
+        {
+            if (snapshot != seen[0])
+            {
+                roundFailures.fetch_add(1);
+            }
+        }
+        failures += roundFailures.load() + (loads.load() == 1 ? 0 : 1);
+    }
+
+    test::Expect(failures == 0, "load coordinator stress detected " + std::to_string(failures) + " failures");
+}
@@ -0,0 +1,34 @@
+#include "Test.h"
+
+#include "../lib/UI/src/Resample.h"
+
+#include <vector>
+
+// Every level halves the one above it, rounding up, down to a one-pixel side, and each
+// control size below the authored one has a level that covers it.
+void TestMipChain()
+{
+    const fixtures::DecodedAtlas body = fixtures::DecodeAtlas(ui::kBodyAtlasLayout);
+    const ui::ImageView source{body.pixels.data(), body.width, body.height, body.width * 4};
+    const ui::TileRect bounds = body.visibleBounds[0];
+    const std::vector<ui::MipLevel> chain = ui::BuildMipChain(source, bounds);
+
+    int width = bounds.width;
+    int height = bounds.height;
+    for (const ui::MipLevel& level : chain)
+    {
+        width = (width + 1) / 2;
+        height = (height + 1) / 2;
+        test::Expect(level.width == width && level.height == height && level.pixels.size() == static_cast<std::size_t>(width) * height * 4,
+            "mip level has the wrong size");
+    }
+    test::Expect(!chain.empty() && (chain.back().width == 1 || chain.back().height == 1), "mip chain does not end at a one-pixel side");
+
+    const ui::TileRect targets[] = {{0, 0, 150, 60}, {0, 0, 120, 50}, {0, 0, 60, 24}};
+    for (const ui::TileRect& target : targets)
+    {
+        const ui::MipLevel* level = ui::SelectMipLevel(chain, target.width, target.height);
+        test::Expect(level != nullptr && level->width >= target.width && level->height >= target.height,
+            "no mip level covers the target size");
+    }
+}
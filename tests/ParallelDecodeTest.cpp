@@ -0,0 +1,63 @@
+#include "Test.h"
+
+#include "../lib/UI/src/Parallel.h"
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const ui::AtlasLayout kLayouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+constexpr std::size_t kLayoutCount = sizeof(kLayouts) / sizeof(kLayouts[0]);
+
+// Large enough that PremultiplyRgbaToBgraRows splits it into one band per core.
+constexpr int kBandImageWidth = 2048;
+constexpr int kBandImageHeight = 1024;
+} // namespace
+
+// Atlases decoded with ParallelFor match decoding them one after another.
+void TestParallelDecode()
+{
+    fixtures::DecodedAtlas parallel[kLayoutCount];
+    ui::ParallelFor(kLayoutCount, [&](std::size_t i) { parallel[i] = fixtures::DecodeAtlas(kLayouts[i]); });
+    for (std::size_t i = 0; i < kLayoutCount; ++i)
+    {
+        const fixtures::DecodedAtlas serial = fixtures::DecodeAtlas(kLayouts[i]);
+        test::Expect(serial.width == parallel[i].width && serial.height == parallel[i].height && serial.pixels == parallel[i].pixels,
+            std::string("parallel decode differs for ") + kLayouts[i].name);
+    }
+}
+
+// The banded premultiply matches a single pass over the whole image.
+void TestBandedPremultiply()
+{
+    const std::size_t pixelCount = static_cast<std::size_t>(kBandImageWidth) * kBandImageHeight;
+    std::vector<unsigned char> source(pixelCount * 4);
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        source[i] = static_cast<unsigned char>(i * 31 + (i >> 9));
+    }
+    std::vector<unsigned char> singlePass(source.size());
+    std::vector<unsigned char> banded(source.size());
+    ui::PremultiplyRgbaToBgra(source.data(), singlePass.data(), pixelCount);
+    ui::PremultiplyRgbaToBgraRows(source.data(), banded.data(), kBandImageWidth, kBandImageHeight);
+    test::Expect(singlePass == banded, "banded premultiply differs from the single pass");
+}
+
+// A ParallelFor inside a task, as the atlas loader's premultiply is, stays on that task's
+// thread instead of fanning out again.
+void TestNestedParallelFor()
+{
+    std::vector<std::thread::id> outer(kLayoutCount);
+    std::vector<std::thread::id> inner(kLayoutCount * 8);
+    ui::ParallelFor(kLayoutCount, [&](std::size_t i) {
+        outer[i] = std::this_thread::get_id();
+        ui::ParallelFor(8, [&](std::size_t j) { inner[i * 8 + j] = std::this_thread::get_id(); });
+    });
+    for (std::size_t i = 0; i < inner.size(); ++i)
+    {
+        test::Expect(inner[i] == outer[i / 8], "nested ParallelFor left its task's thread");
+    }
+}
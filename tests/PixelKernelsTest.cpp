@@ -0,0 +1,61 @@
+#include "Test.h"
+
+#include "../lib/UI/src/PixelKernels.h"
+
+#include <vector>
+
+namespace
+{
+const ui::PixelKernel kKernels[] = {ui::PixelKernel::Scalar, ui::PixelKernel::Sse2, ui::PixelKernel::Avx2, ui::PixelKernel::Neon};
+
+// Every (color, alpha) pair in each channel position, with an odd pixel count so the
+// scalar tails of the vector kernels are exercised too.
+std::vector<unsigned char> BuildExhaustiveInput()
+{
+    std::vector<unsigned char> pixels;
+    for (int alpha = 0; alpha < 256; ++alpha)
+    {
+        for (int color = 0; color < 256; ++color)
+        {
+            const unsigned char pixel[4] = {
+                static_cast<unsigned char>(color),
+                static_cast<unsigned char>(255 - color),
+                static_cast<unsigned char>(color ^ 0x5A),
+                static_cast<unsigned char>(alpha)};
+            pixels.insert(pixels.end(), pixel, pixel + 4);
+        }
+    }
+    pixels.insert(pixels.end(), {1, 2, 3, 200, 4, 5, 6, 7, 250, 128, 0, 129});
+    return pixels;
+}
+
+void VerifyAgainstScalar(ui::PixelKernel kernel, const std::vector<unsigned char>& input)
+{
+    const std::size_t pixelCount = input.size() / 4;
+    std::vector<unsigned char> expected(input.size());
+    std::vector<unsigned char> actual(input.size());
+    ui::PremultiplyRgbaToBgra(ui::PixelKernel::Scalar, input.data(), expected.data(), pixelCount);
+    ui::PremultiplyRgbaToBgra(kernel, input.data(), actual.data(), pixelCount);
+
+    std::vector<unsigned char> inPlace = input;
+    ui::PremultiplyRgbaToBgra(kernel, inPlace.data(), inPlace.data(), pixelCount);
+
+    test::Expect(actual == expected && inPlace == expected, std::string("premultiply kernel mismatch: ") + ui::PixelKernelName(kernel));
+}
+} // namespace
+
+// Each supported premultiply kernel, out of place and in place, bit-for-bit against the
+// scalar reference on every (color, alpha) pair and on the body atlas.
+void TestPixelKernels()
+{
+    const std::vector<unsigned char> exhaustive = BuildExhaustiveInput();
+    const fixtures::RgbaImage image = fixtures::LoadAssetImage("switch-body.png");
+    for (ui::PixelKernel kernel : kKernels)
+    {
+        if (ui::IsPixelKernelSupported(kernel))
+        {
+            VerifyAgainstScalar(kernel, exhaustive);
+            VerifyAgainstScalar(kernel, image.pixels);
+        }
+    }
+}
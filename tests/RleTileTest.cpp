@@ -0,0 +1,107 @@
+#include "Test.h"
+
+#include "../lib/UI/src/AtlasLoader.h"
+#include "../lib/UI/src/AtlasPacker.h"
+#include "../lib/UI/src/Resample.h"
+#include "../lib/UI/src/RleTile.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+void Expect(bool condition, const char* what)
+{
+    test::Expect(condition, std::string("compressed tiles: ") + what);
+}
+
+std::vector<unsigned char> Backdrop(int width, int height)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        pixels[i] = static_cast<unsigned char>(i * 5);
+        pixels[i + 1] = static_cast<unsigned char>(i * 11);
+        pixels[i + 2] = static_cast<unsigned char>(i * 3);
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+// Inflating gives back rect of image, and blitting leaves every target byte as
+// CompositeSrcOver of the raw pixels does, at any offset and clip.
+void VerifyTile(const ui::ImageView& image, const ui::TileRect& rect, const ui::RleTile& tile)
+{
+    std::vector<unsigned char> inflated(static_cast<std::size_t>(rect.width) * rect.height * 4);
+    ui::DecompressTile(tile, ui::SurfaceView{inflated.data(), rect.width, rect.height, rect.width * 4});
+    for (int y = 0; y < rect.height; ++y)
+    {
+        const unsigned char* row = image.pixels + static_cast<std::ptrdiff_t>(rect.y + y) * image.stride + static_cast<std::ptrdiff_t>(rect.x) * 4;
+        Expect(std::memcmp(row, inflated.data() + static_cast<std::size_t>(y) * rect.width * 4, static_cast<std::size_t>(rect.width) * 4) == 0,
+            "inflated tile differs from the raw pixels");
+    }
+
+    const int width = rect.width + 30;
+    const int height = rect.height + 16;
+    const ui::TileRect destinations[] = {
+        {15, 8, rect.width, rect.height},
+        {-11, -3, rect.width, rect.height},
+        {width - rect.width / 3, height - rect.height / 2, rect.width, rect.height},
+    };
+    const ui::TileRect clips[] = {
+        {0, 0, width, height},
+        {9, 5, rect.width / 2, rect.height / 3 + 1},
+        {width / 3, 0, 1, height},
+    };
+    for (const ui::TileRect& destination : destinations)
+    {
+        for (const ui::TileRect& clip : clips)
+        {
+            std::vector<unsigned char> expected = Backdrop(width, height);
+            std::vector<unsigned char> actual = expected;
+            ui::CompositeSrcOver(ui::SurfaceView{expected.data(), width, height, width * 4}, destination, image, rect, clip);
+            ui::CompositeSrcOverRle(ui::SurfaceView{actual.data(), width, height, width * 4}, destination, tile, clip);
+            Expect(expected == actual, "compressed blit differs from CompositeSrcOver");
+        }
+    }
+}
+} // namespace
+
+// Every visible tile part of both atlases, and the body and knob tiles at the default control
+// size, round-trip through compression and blit like the raw pixels.
+void TestRleTiles()
+{
+    const ui::AtlasLayout layouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+    for (const ui::AtlasLayout& layout : layouts)
+    {
+        const fixtures::DecodedAtlas atlas = fixtures::DecodeAtlas(layout);
+        const ui::PackedAtlas packed = ui::PackVisibleTiles(atlas.pixels.data(), atlas.width, atlas.visibleBounds);
+        const ui::ImageView source{packed.pixels.data(), packed.width, packed.height, packed.width * 4};
+        for (const ui::TileRect& bounds : packed.packedBounds)
+        {
+            VerifyTile(source, bounds, ui::CompressTile(source, bounds));
+        }
+
+        std::vector<unsigned char> scaled(static_cast<std::size_t>(315) * 125 * 4);
+        ui::ResampleImage(source, packed.packedBounds[0], ui::SurfaceView{scaled.data(), 315, 125, 315 * 4});
+        const ui::ImageView scaledView{scaled.data(), 315, 125, 315 * 4};
+        const ui::TileRect scaledRect{0, 0, 315, 125};
+        VerifyTile(scaledView, scaledRect, ui::CompressTile(scaledView, scaledRect));
+    }
+}
+
+// A loaded toggle keeps only the compressed tiles and their mip chains resident.
+void TestRleResident()
+{
+    const std::unique_ptr<ui::ToggleAtlases> atlases = ui::LoadToggleAtlases([](const ui::AtlasLayout& layout) {
+        return ui::LoadAtlasFromDirectory(fixtures::AssetDirectory(), layout);
+    });
+    for (const ui::ImageAtlas* atlas : {&atlases->body, &atlases->knob})
+    {
+        Expect(atlas->pixels == nullptr && atlas->decoded.empty(), "raw pixels stayed resident");
+        Expect(atlas->compressed.size() == atlas->tiles.size(), "a tile was not compressed");
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Fixtures.h"
+
+#include <stdexcept>
+#include <string>
+
+// Minimal check harness for the UIToggle tests. A failed check throws; TestMain.cpp reports
+// the failure and exits non-zero, so each test is a CTest pass/fail.
+namespace test
+{
+inline void Expect(bool condition, const std::string& what)
+{
+    if (!condition)
+    {
+        throw std::runtime_error(what);
+    }
+}
+
+// Whether fn throws std::runtime_error.
+template <typename Fn>
+bool Throws(Fn&& fn)
+{
+    try
+    {
+        fn();
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+} // namespace test
+
+void TestPixelKernels();
+void TestAtlasFileRoundTrip();
+void TestAtlasFileRejects();
+void TestLoadCoordinator();
+void TestParallelDecode();
+void TestBandedPremultiply();
+void TestNestedParallelFor();
+void TestDirectDecode();
+void TestBlendEquation();
+void TestBlendKernels();
+void TestGoldenFrames();
+void TestHeadlessRender();
+void TestHeadlessArguments();
+void TestDirtyRect();
+void TestDirtyRectColdCache();
+void TestFrameCacheGoldens();
+void TestFrameCacheEviction();
+void TestFrameCacheBudget();
+void TestResampler();
+void TestTileCache();
+void TestMipChain();
+void TestAtlasPack();
+void TestRleTiles();
+void TestRleResident();
+void TestAnimationScheduler();
+void TestAnimationCurves();
+void TestAnimationKernels();
+void TestAnimationSprings();
+void TestAnimationSettle();
+void TestAnimationBulk();
+void TestHeadlessKnobOffsetLimits();
+
+#if defined(UI_TOGGLE_EMBEDDED_ATLASES)
+void TestEmbeddedAtlases();
+#endif
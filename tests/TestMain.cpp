@@ -0,0 +1,102 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+
+namespace
+{
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+};
+
+// CTest runs each of these on its own (CMakeLists.txt registers the same names).
+const TestCase kTests[] = {
+    {"PixelKernels", TestPixelKernels},
+    {"AtlasFileRoundTrip", TestAtlasFileRoundTrip},
+    {"AtlasFileRejects", TestAtlasFileRejects},
+    {"LoadCoordinator", TestLoadCoordinator},
+    {"ParallelDecode", TestParallelDecode},
+    {"BandedPremultiply", TestBandedPremultiply},
+    {"NestedParallelFor", TestNestedParallelFor},
+    {"DirectDecode", TestDirectDecode},
+    {"BlendEquation", TestBlendEquation},
+    {"BlendKernels", TestBlendKernels},
+    {"GoldenFrames", TestGoldenFrames},
+    {"HeadlessRender", TestHeadlessRender},
+    {"HeadlessArguments", TestHeadlessArguments},
+    {"DirtyRect", TestDirtyRect},
+    {"DirtyRectColdCache", TestDirtyRectColdCache},
+    {"FrameCacheGoldens", TestFrameCacheGoldens},
+    {"FrameCacheEviction", TestFrameCacheEviction},
+    {"FrameCacheBudget", TestFrameCacheBudget},
+    {"Resampler", TestResampler},
+    {"TileCache", TestTileCache},
+    {"MipChain", TestMipChain},
+    {"AtlasPack", TestAtlasPack},
+    {"RleTiles", TestRleTiles},
+    {"RleResident", TestRleResident},
+    {"AnimationScheduler", TestAnimationScheduler},
+    {"AnimationCurves", TestAnimationCurves},
+    {"AnimationKernels", TestAnimationKernels},
+    {"AnimationSprings", TestAnimationSprings},
+    {"AnimationSettle", TestAnimationSettle},
+    {"AnimationBulk", TestAnimationBulk},
+    {"HeadlessKnobOffsetLimits", TestHeadlessKnobOffsetLimits},
+#if defined(UI_TOGGLE_EMBEDDED_ATLASES)
+    {"EmbeddedAtlases", TestEmbeddedAtlases},
+#endif
+};
+
+bool Run(const TestCase& test)
+{
+    std::printf("[ RUN    ] %s\n", test.name);
+    try
+    {
+        test.run();
+    }
+    catch (const std::exception& error)
+    {
+        std::printf("[ FAILED ] %s: %s\n", test.name, error.what());
+        return false;
+    }
+    std::printf("[     OK ] %s\n", test.name);
+    return true;
+}
+} // namespace
+
+// Usage: UIToggleTests [test-name...]; without names every test runs.
+int main(int argc, char** argv)
+{
+    int failures = 0;
+    if (argc == 1)
+    {
+        for (const TestCase& test : kTests)
+        {
+            failures += Run(test) ? 0 : 1;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const TestCase* match = nullptr;
+        for (const TestCase& test : kTests)
+        {
+            if (std::strcmp(test.name, argv[i]) == 0)
+            {
+                match = &test;
+            }
+        }
+        if (match == nullptr)
+        {
+            std::printf("unknown test: %s\n", argv[i]);
+            ++failures;
+            continue;
+        }
+        failures += Run(*match) ? 0 : 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#include "Test.h"
+
+#include "../lib/UI/src/Resample.h"
+#include "../lib/UI/src/TileCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace
+{
+void Expect(bool condition, const char* what)
+{
+    test::Expect(condition, std::string("tile resampling: ") + what);
+}
+
+std::vector<unsigned char> Resample(const ui::ImageView& source, const ui::TileRect& sourceRect, int width, int height)
+{
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * 4);
+    ui::ResampleImage(source, sourceRect, ui::SurfaceView{pixels.data(), width, height, width * 4});
+    return pixels;
+}
+} // namespace
+
+// Filter invariants: same size is a copy, a flat color stays flat whichever way it is scaled,
+// and premultiplied pixels stay premultiplied (no channel above alpha).
+void TestResampler()
+{
+    const fixtures::DecodedAtlas atlas = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+    const ui::ImageView source{atlas.pixels.data(), atlas.width, atlas.height, atlas.width * 4};
+    const ui::TileRect tile = atlas.tiles[1];
+
+    const std::vector<unsigned char> copy = Resample(source, tile, tile.width, tile.height);
+    for (int y = 0; y < tile.height; ++y)
+    {
+        const unsigned char* row = atlas.pixels.data() + (static_cast<std::size_t>(tile.y + y) * atlas.width + tile.x) * 4;
+        Expect(std::equal(row, row + tile.width * 4, copy.begin() + static_cast<std::ptrdiff_t>(y) * tile.width * 4), "same-size resample is not a copy");
+    }
+
+    const unsigned char flat[4] = {40, 80, 120, 200};
+    std::vector<unsigned char> flatPixels;
+    for (int i = 0; i < 37 * 23; ++i)
+    {
+        flatPixels.insert(flatPixels.end(), flat, flat + 4);
+    }
+    const ui::ImageView flatSource{flatPixels.data(), 37, 23, 37 * 4};
+    for (const ui::TileRect size : {ui::TileRect{0, 0, 11, 7}, ui::TileRect{0, 0, 100, 61}, ui::TileRect{0, 0, 13, 50}})
+    {
+        const std::vector<unsigned char> scaled = Resample(flatSource, ui::TileRect{0, 0, 37, 23}, size.width, size.height);
+        for (std::size_t i = 0; i < scaled.size(); ++i)
+        {
+            Expect(scaled[i] == flat[i % 4], "a flat color changed when scaled");
+        }
+    }
+
+    for (const ui::TileRect size : {ui::TileRect{0, 0, tile.width / 3, tile.height / 3}, ui::TileRect{0, 0, tile.width * 2 + 1, tile.height * 2 - 1}})
+    {
+        const std::vector<unsigned char> scaled = Resample(source, atlas.visibleBounds[1], size.width, size.height);
+        for (std::size_t i = 0; i < scaled.size(); i += 4)
+        {
+            Expect(scaled[i] <= scaled[i + 3] && scaled[i + 1] <= scaled[i + 3] && scaled[i + 2] <= scaled[i + 3], "a scaled pixel is not premultiplied");
+        }
+    }
+}
+
+// A repeated lookup returns the cached tile, and the byte budget evicts the least recently used
+// tile first.
+void TestTileCache()
+{
+    const fixtures::DecodedAtlas knob = fixtures::DecodeAtlas(ui::kSwitchAtlasLayout);
+    const ui::ImageView source{knob.pixels.data(), knob.width, knob.height, knob.width * 4};
+    const ui::TileRect sourceRect = knob.visibleBounds[2];
+    const int width = 630;
+    const int height = 250;
+    const std::size_t tileBytes = static_cast<std::size_t>(width) * height * 4;
+
+    // Room for two scaled tiles: the least recently used one goes when a third arrives.
+    ui::ScaledTileCache cache(tileBytes * 2);
+    const auto first = ui::GetScaledTile(cache, source, sourceRect, width, height);
+    cache.SetByteBudget(first->ByteSize() * 2 + first->ByteSize() / 2);
+    Expect(ui::GetScaledTile(cache, source, sourceRect, width, height) == first, "a repeated lookup resampled again");
+    ui::GetScaledTile(cache, source, sourceRect, width, height - 1);
+    ui::GetScaledTile(cache, source, sourceRect, width, height);
+    ui::GetScaledTile(cache, source, sourceRect, width, height - 2);
+    const ui::CacheStats stats = cache.Stats();
+    Expect(stats.entries == 2 && stats.bytesUsed <= stats.byteBudget, "budget not enforced");
+    Expect(ui::GetScaledTile(cache, source, sourceRect, width, height) == first, "the most recently used tile was evicted");
+    Expect(cache.Stats().misses == stats.misses, "the most recently used tile was resampled again");
+}
@@ -0,0 +1,143 @@
+// Offline asset baker: converts the toggle PNG atlases into .tglatlas files that the DLL
+// maps at startup instead of decoding PNGs, or into a C++ translation unit that compiles
+// them into the binary (see EmbeddedAtlases.h).
+//
+// Usage: UIAtlasBaker <png-directory> <output-directory>
+//        UIAtlasBaker --embed <png-directory> <output.cpp>
+
+#include "../lib/UI/src/AtlasFile.h"
+#include "../lib/UI/src/ImageDecode.h"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+const ui::AtlasLayout kLayouts[] = {ui::kBodyAtlasLayout, ui::kSwitchAtlasLayout};
+
+std::vector<unsigned char> BakeAtlas(const std::string& inputDir, const ui::AtlasLayout& layout)
+{
+    const std::string inputPath = inputDir + "/" + layout.name + ".png";
+
+    int width = 0;
+    int height = 0;
+    ui::ReadImageSize(inputPath.c_str(), width, height);
+    std::vector<unsigned char> rgba(static_cast<std::size_t>(width) * height * 4);
+    ui::DecodeRgbaInto(inputPath.c_str(), rgba.data(), width, height);
+
+    std::vector<unsigned char> bytes = ui::BakeAtlasFile(rgba.data(), width, height, layout);
+
+    // Parse the result with the runtime validator so a bad bake fails the build.
+    const ui::AtlasFileView view = ui::ParseAtlasFile(bytes.data(), bytes.size());
+    std::printf("baked %s: %dx%d, %d tiles, %zu bytes\n", layout.name, view.width, view.height, view.tileCount, bytes.size());
+    return bytes;
+}
+
+void WriteAtlasFiles(const std::string& inputDir, const std::string& outputDir)
+{
+    for (const ui::AtlasLayout& layout : kLayouts)
+    {
+        ui::WriteAtlasFile(outputDir + "/" + layout.name + ".tglatlas", BakeAtlas(inputDir, layout));
+    }
+}
+
+void WriteTextFile(const std::string& path, const std::string& text)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        throw std::runtime_error("Failed to open " + path + " for writing");
+    }
+
+    const std::size_t written = std::fwrite(text.data(), 1, text.size(), file);
+    const bool closed = std::fclose(file) == 0;
+    if (written != text.size() || !closed)
+    {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+// Emits one constexpr byte array per atlas plus the FindEmbeddedAtlas lookup.
+void WriteEmbeddedSource(const std::string& inputDir, const std::string& outputPath)
+{
+    std::string source =
+        "// Generated by UIAtlasBaker --embed. Do not edit.\n"
+        "#include \"EmbeddedAtlases.h\"\n"
+        "\n"
+        "#include <cstring>\n"
+        "\n"
+        "namespace ui\n"
+        "{\n"
+        "namespace\n"
+        "{\n";
+
+    std::string table;
+    for (std::size_t index = 0; index < sizeof(kLayouts) / sizeof(kLayouts[0]); ++index)
+    {
+        const std::vector<unsigned char> bytes = BakeAtlas(inputDir, kLayouts[index]);
+        const std::string symbol = "kAtlas" + std::to_string(index);
+
+        // Tables inside the image are read in place, so keep the file's pixel alignment.
+        source += "alignas(" + std::to_string(ui::kAtlasFilePixelAlignment) + ") constexpr unsigned char " + symbol + "[] = {";
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            source += (i % 32 == 0) ? "\n    " : "";
+            source += std::to_string(bytes[i]) + ",";
+        }
+        source += "\n};\n\n";
+
+        table += "    {\"" + std::string(kLayouts[index].name) + "\", " + symbol + ", sizeof(" + symbol + ")},\n";
+    }
+
+    source +=
+        "constexpr EmbeddedAtlas kEmbeddedAtlases[] = {\n" + table + "};\n"
+        "} // namespace\n"
+        "\n"
+        "const EmbeddedAtlas* FindEmbeddedAtlas(const char* name)\n"
+        "{\n"
+        "    for (const EmbeddedAtlas& atlas : kEmbeddedAtlases)\n"
+        "    {\n"
+        "        if (std::strcmp(atlas.name, name) == 0)\n"
+        "        {\n"
+        "            return &atlas;\n"
+        "        }\n"
+        "    }\n"
+        "    return nullptr;\n"
+        "}\n"
+        "} // namespace ui\n";
+
+    WriteTextFile(outputPath, source);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const bool embed = argc == 4 && std::strcmp(argv[1], "--embed") == 0;
+    if (argc != 3 && !embed)
+    {
+        std::fprintf(stderr, "usage: %s [--embed] <png-directory> <output-directory | output.cpp>\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        if (embed)
+        {
+            WriteEmbeddedSource(argv[2], argv[3]);
+        }
+        else
+        {
+            WriteAtlasFiles(argv[1], argv[2]);
+        }
+    }
+    catch (const std::exception& error)
+    {
+        std::fprintf(stderr, "UIAtlasBaker: %s\n", error.what());
+        return 1;
+    }
+
+    return 0;
+}